@@ -1,56 +1,64 @@
 #include "cargoMode.h"
+#include <stdexcept>
 
 cargoMode::cargoMode()
 {
-	if (!m_cargoTexture.loadFromFile("./resources/images/ammoBox.png"))
-	{
-		std::string s("Error loading ammoBox");
-		throw std::exception(s.c_str());
-	}
-
-	m_cargoSprite.setTexture(m_cargoTexture);
+	// the texture rects match the image sizes so collisions work without any texture loaded
+	m_cargoSprite.setTextureRect(sf::IntRect(0, 0, 1500, 1500));
 	m_cargoSprite.setScale(0.05, 0.05);
 
 	m_cargoSprite.setPosition(200, 100);
 
-	if (!m_goalTexture.loadFromFile("./resources/images/base.png"))
-	{
-		std::string s("Error loading base");
-		throw std::exception(s.c_str());
-	}
-
-	m_goalSprite.setTexture(m_goalTexture);
+	m_goalSprite.setTextureRect(sf::IntRect(0, 0, 600, 600));
 	m_goalSprite.setScale(0.2, 0.2);
 
 	m_goalSprite.setPosition(1200, 700);
 
-	if (!m_fuelPickUpTexture.loadFromFile("./resources/images/fuelPickUp.png"))
-	{
-		std::string s("Error loading fuel pickup");
-		throw std::exception(s.c_str());
-	}
-
-	m_fuelPickUpSprite.setTexture(m_fuelPickUpTexture);
+	m_fuelPickUpSprite.setTextureRect(sf::IntRect(0, 0, 768, 768));
 	m_fuelPickUpSprite.setScale(0.08, 0.08);
 
 	m_fuelPickUpSprite.setPosition(650, 375);
+
+	m_cargoBox.set(m_cargoSprite);
+	m_goalBox.set(m_goalSprite);
+	m_fuelPickUpBox.set(m_fuelPickUpSprite);
+}
+
+void cargoMode::setTextures(sf::Texture const& t_cargoTexture, sf::IntRect const& t_cargoRect,
+	sf::Texture const& t_goalTexture, sf::IntRect const& t_goalRect,
+	sf::Texture const& t_fuelPickUpTexture, sf::IntRect const& t_fuelPickUpRect)
+{
+	// the boxes were built from the image sizes, so only the position of each image can change
+	if (t_cargoRect.width != m_cargoSprite.getTextureRect().width || t_cargoRect.height != m_cargoSprite.getTextureRect().height
+		|| t_goalRect.width != m_goalSprite.getTextureRect().width || t_goalRect.height != m_goalSprite.getTextureRect().height
+		|| t_fuelPickUpRect.width != m_fuelPickUpSprite.getTextureRect().width || t_fuelPickUpRect.height != m_fuelPickUpSprite.getTextureRect().height)
+	{
+		throw std::runtime_error("Pickup images do not match the sizes the pickups were built with");
+	}
+
+	m_cargoSprite.setTexture(t_cargoTexture);
+	m_cargoSprite.setTextureRect(t_cargoRect);
+	m_goalSprite.setTexture(t_goalTexture);
+	m_goalSprite.setTextureRect(t_goalRect);
+	m_fuelPickUpSprite.setTexture(t_fuelPickUpTexture);
+	m_fuelPickUpSprite.setTextureRect(t_fuelPickUpRect);
 }
 
 void cargoMode::update(double dt)
 {
 }
 
-void cargoMode::render(sf::RenderWindow& window)
+void cargoMode::render(SpriteBatch& t_batch)
 {
-	window.draw(m_goalSprite);
+	t_batch.draw(m_goalSprite, DrawLayer::PICKUPS);
 
 	if (m_fuelPickedUp == false)
 	{
-		window.draw(m_fuelPickUpSprite);
+		t_batch.draw(m_fuelPickUpSprite, DrawLayer::PICKUPS);
 	}
 	if (m_cargoCollected == false)
 	{
-		window.draw(m_cargoSprite);
+		t_batch.draw(m_cargoSprite, DrawLayer::PICKUPS);
 	}
 	
 }
@@ -58,8 +66,8 @@ void cargoMode::render(sf::RenderWindow& window)
 bool cargoMode::playerPicksUpCargo(Tank const& playerTank) const
 {
 	// check if player is on cargo
-	if (CollisionDetector::collision(m_cargoSprite, playerTank.getTurret()) ||
-		CollisionDetector::collision(m_cargoSprite, playerTank.getBase()))
+	if (CollisionDetector::collision(m_cargoBox, playerTank.getTurretBox()) ||
+		CollisionDetector::collision(m_cargoBox, playerTank.getBaseBox()))
 	{
 		return true;
 	}
@@ -70,8 +78,8 @@ bool cargoMode::playerPicksUpCargo(Tank const& playerTank) const
 bool cargoMode::playerPicksUpFuel(Tank const& playerTank) const
 {
 	// check if player is on fuel
-	if (CollisionDetector::collision(m_fuelPickUpSprite, playerTank.getTurret()) ||
-		CollisionDetector::collision(m_fuelPickUpSprite, playerTank.getBase()))
+	if (CollisionDetector::collision(m_fuelPickUpBox, playerTank.getTurretBox()) ||
+		CollisionDetector::collision(m_fuelPickUpBox, playerTank.getBaseBox()))
 	{
 		return true;
 	}
@@ -81,10 +89,40 @@ bool cargoMode::playerPicksUpFuel(Tank const& playerTank) const
 bool cargoMode::playerArrivesAtGoal(Tank const& playerTank) const
 {
 	// check if player is on goal
-	if (CollisionDetector::collision(m_goalSprite, playerTank.getTurret()) ||
-		CollisionDetector::collision(m_goalSprite, playerTank.getBase()))
+	if (CollisionDetector::collision(m_goalBox, playerTank.getTurretBox()) ||
+		CollisionDetector::collision(m_goalBox, playerTank.getBaseBox()))
 	{
 		return true;
 	}
 	return false;
 }
+
+sf::Vector2f cargoMode::getCargoCentre() const
+{
+	sf::FloatRect bounds = m_cargoSprite.getGlobalBounds();
+	return sf::Vector2f(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
+}
+
+sf::Vector2f cargoMode::getGoalCentre() const
+{
+	sf::FloatRect bounds = m_goalSprite.getGlobalBounds();
+	return sf::Vector2f(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
+}
+
+sf::Vector2f cargoMode::getFuelPickUpCentre() const
+{
+	sf::FloatRect bounds = m_fuelPickUpSprite.getGlobalBounds();
+	return sf::Vector2f(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
+}
+
+void cargoMode::saveState(StateWriter& t_writer) const
+{
+	t_writer.write(m_cargoCollected);
+	t_writer.write(m_fuelPickedUp);
+}
+
+void cargoMode::loadState(StateReader& t_reader)
+{
+	t_reader.read(m_cargoCollected);
+	t_reader.read(m_fuelPickedUp);
+}
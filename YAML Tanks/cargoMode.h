@@ -1,7 +1,6 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
-#include <SFML/Audio.hpp>
 #include "CollisionDetector.h"
 #include "Tank.h"
 
@@ -11,9 +10,16 @@ class cargoMode
 public:
 	cargoMode();
 
+	// gives the pickup and goal sprites their textures and where their images are in them, only
+	// needed when the sprites are drawn. The rects must be the size of the original images
+	void setTextures(sf::Texture const& t_cargoTexture, sf::IntRect const& t_cargoRect,
+		sf::Texture const& t_goalTexture, sf::IntRect const& t_goalRect,
+		sf::Texture const& t_fuelPickUpTexture, sf::IntRect const& t_fuelPickUpRect);
+
 	void update(double dt);
 
-	void render(sf::RenderWindow& window);
+	// adds the goal and any pickups not yet collected to the batch
+	void render(SpriteBatch& t_batch);
 
 	bool playerPicksUpCargo(Tank const& playerTank) const;
 
@@ -21,19 +27,28 @@ public:
 
 	bool playerArrivesAtGoal(Tank const& playerTank) const;
 
+	// centres of the pickups and goal, used by the player bot to find its way
+	sf::Vector2f getCargoCentre() const;
+	sf::Vector2f getGoalCentre() const;
+	sf::Vector2f getFuelPickUpCentre() const;
+
+	// saves and restores which pickups have been collected, for replay keyframes
+	void saveState(StateWriter& t_writer) const;
+	void loadState(StateReader& t_reader);
+
 	bool m_cargoCollected = false;
 	bool m_fuelPickedUp = false;
 
 private:
 
 	sf::Sprite m_cargoSprite;
-	sf::Texture m_cargoTexture;
-
 	sf::Sprite m_goalSprite;
-	sf::Texture m_goalTexture;
-
 	sf::Sprite m_fuelPickUpSprite;
-	sf::Texture m_fuelPickUpTexture;
+
+	// the pickups and goal never move, so their boxes are built once
+	OrientedBoundingBox m_cargoBox;
+	OrientedBoundingBox m_goalBox;
+	OrientedBoundingBox m_fuelPickUpBox;
 
 
 };
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "OrientedBoundingBox.h"
+
+/// <summary>
+/// @brief A batch of oriented bounding boxes stored as a structure of arrays.
+///
+/// Each field of every box (corner x and y, edge axes, projection intervals) has its own
+///  contiguous array, so CollisionDetector::collisionMask() can load 4 or 8 boxes' worth
+///  of one field with a single SSE or AVX load.
+/// Example usage:
+///		BoxBatch batch;
+///		for (int wall : nearbyWalls) batch.add(walls.box(wall));
+///		std::uint32_t hits = CollisionDetector::collisionMask(tankBox, batch, 0, batch.size());
+/// </summary>
+class BoxBatch
+{
+public:
+	void clear();
+
+	void add(OrientedBoundingBox const& t_box);
+
+	int size() const;
+
+	// the four corners of each box
+	std::vector<float> m_cornerX[4];
+	std::vector<float> m_cornerY[4];
+
+	// the two edge axes of each box and the box's projection onto them
+	std::vector<float> m_axisX[2];
+	std::vector<float> m_axisY[2];
+	std::vector<float> m_axisMin[2];
+	std::vector<float> m_axisMax[2];
+
+private:
+	int m_size = 0;
+};
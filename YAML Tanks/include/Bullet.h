@@ -1,9 +1,12 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <SFML/Audio.hpp>
 #include "CollisionDetector.h"
 #include "Globals.h"
 #include "LevelLoader.h"
+#include "InputCommand.h"
+#include "StateStream.h"
+#include "StaticColliders.h"
+#include "SpriteBatch.h"
 
 // needed by "playerCollision" function, but cant be used. Causes multiple compiler errors
 //#include "Tank.h"
@@ -29,17 +32,47 @@ public:
 	/// <param name="t_targets"></param>
 	void update(double dt);
 
-	void render(sf::RenderWindow& window);
+	/// <summary>
+	/// @brief Draws the bullet blended between the previous and current step.
+	/// A bullet that was fired during the step is drawn where it is now, and a bullet that is
+	///  not travelling is off screen so is not drawn at all.
+	/// </summary>
+	/// <param name="t_batch">The batch the sprite is added to</param>
+	/// <param name="alpha">How far the frame is between the previous and current step (0 to 1)</param>
+	void render(SpriteBatch& t_batch, float alpha);
+
+	// remembers the current position as the previous step's, called before each step
+	void storePreviousState();
+
+	// saves and restores the bullet's flight, for replay keyframes
+	void saveState(StateWriter& t_writer) const;
+	void loadState(StateReader& t_reader);
 
 	void setPosition(sf::Vector2f& position);
 
-	// keys if player has pressed space to fire bullet
-	void handleKeyInputs();
+	// checks if player has asked to fire a bullet this tick
+	void handleKeyInputs(InputCommand const& t_input);
 
-	// checks for wall collisions with bullet
-	void wallCollision(std::vector<sf::Sprite>& t_wallSprites);
-	// checks for target collisons with bullet and toggles target active status
-	void targetCollision(std::vector<sf::Sprite>& t_targetSprites, std::vector<TargetData>& t_targets);
+	/// <summary>
+	/// @brief Checks the bullet's path this step against the walls, and resets it if it hit one or
+	///  has left the game world.
+	/// The whole path from where the bullet started the step is swept, so it cannot pass through
+	///  a wall however far it moved. Only the walls the grid finds along the path are tested.
+	/// </summary>
+	/// <param name="t_walls">The baked wall boxes</param>
+	/// <returns>True if the bullet hit a wall.</returns>
+	bool wallCollision(StaticColliders const& t_walls);
+
+	/// <summary>
+	/// @brief Checks the bullet's path this step against the active target and toggles target
+	///  status if it was hit.
+	/// Call before wallCollision(), a target only counts as hit if the bullet reaches it before
+	///  any wall.
+	/// </summary>
+	/// <param name="t_walls">The baked wall boxes, to find when the bullet would hit a wall</param>
+	/// <param name="t_targetBoxes">The baked target boxes</param>
+	/// <param name="t_targets">Target data, whose flags are updated when a target is hit</param>
+	void targetCollision(StaticColliders const& t_walls, std::vector<OrientedBoundingBox> const& t_targetBoxes, std::vector<TargetData>& t_targets);
 
 
 	// BROKEN
@@ -52,9 +85,6 @@ public:
 	// init bullets, called in tank constructor 
 	void initBullet(sf::Texture const& texture);
 
-	// load and init sound files
-	void initSounds();
-
 
 	// control bools
 	bool m_canFire = true; // allows a bullet to be fired
@@ -65,11 +95,27 @@ public:
 private:
 
 	sf::Sprite m_bulletSprite;
-	sf::Texture m_texture;
 
-	// sound for bullet hiting a wall
-	sf::SoundBuffer m_wallHitBuffer;
-	sf::Sound m_wallHitSound;
+	// position and travel state at the start of the current step, used to interpolate rendering
+	sf::Vector2f m_renderPosition;
+	bool m_renderTraveling = false;
+
+	// finds the fraction of this step's path at which the bullet first touches a wall, worked out
+	// once per step and shared by the wall and target checks. Returns a value above 1 for no hit
+	float wallImpactTime(StaticColliders const& t_walls);
+
+	// puts the bullet off screen, ready to be fired again
+	void reset();
+
+	// the bullet's box where it started the current step and how far it moved during it
+	OrientedBoundingBox m_sweepBox;
+	sf::Vector2f m_sweepDisplacement;
+
+	float m_wallImpact = 2.0f;
+	bool m_wallImpactFound = false;
+
+	// walls along the bullet's path, reused by every wall collision check
+	std::vector<int> m_nearbyWalls;
 
 	// start point of the bullet's path
 	sf::Vector2f m_startPoint;
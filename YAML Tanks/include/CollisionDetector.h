@@ -2,6 +2,8 @@
 
 #include <SFML/Graphics.hpp>
 #include "OrientedBoundingBox.h"
+#include "BoxBatch.h"
+#include <cstdint>
 
 /// <summary>
 /// @brief Collision detection class for bounding box collisions using the Separating Axis Theorem (SAT)
@@ -20,4 +22,51 @@ class CollisionDetector
 {
 public:
 	bool static collision(const sf::Sprite& object1, const sf::Sprite& object2);
+
+	// The same test for boxes that have already been built, each box's own axis intervals
+	// are reused so only the other box is projected onto them
+	bool static collision(const OrientedBoundingBox& OBB1, const OrientedBoundingBox& OBB2);
+
+	/// <summary>
+	/// @brief Swept version of the test, for a box that moves in a straight line during a step.
+	/// Finds the first moment the moving box touches the other one, so fast or long steps cannot
+	///  carry it through thin walls. Uses the same four axes as collision(): on each the time
+	///  window where the projections overlap is found, and the box hits if the windows share a time.
+	/// </summary>
+	/// <param name="OBB1">The moving box where it starts the step</param>
+	/// <param name="displacement">How far OBB1 moves during the step</param>
+	/// <param name="OBB2">The box that does not move</param>
+	/// <param name="time">Set to the fraction of the step (0 to 1) at first contact, 0 if they already overlap</param>
+	/// <returns>True if the boxes touch at any point during the step.</returns>
+	bool static sweep(const OrientedBoundingBox& OBB1, const sf::Vector2f& displacement, const OrientedBoundingBox& OBB2, float& time);
+
+	// Instruction sets the batch test can use, from slowest to fastest
+	enum class SimdLevel
+	{
+		SCALAR,
+		SSE,
+		AVX
+	};
+
+	/// <summary>
+	/// @brief Tests one box against up to 32 boxes of a batch at once.
+	/// Gives exactly the same answers as collision(OBB1, box) for each box in the batch: every
+	///  path does the same multiplies and adds in the same order and never fuses them, so
+	///  a replay plays out the same on any machine.
+	/// </summary>
+	/// <param name="OBB1">The moving box (tank base, turret or bullet)</param>
+	/// <param name="batch">The boxes to test against, usually the walls near the moving box</param>
+	/// <param name="first">Index of the first box in the batch to test</param>
+	/// <param name="count">Number of boxes to test, at most 32</param>
+	/// <returns>Bit i is set if OBB1 collides with box first + i.</returns>
+	std::uint32_t static collisionMask(const OrientedBoundingBox& OBB1, const BoxBatch& batch, int first, int count);
+
+	// The same test using a particular instruction set, which must be supported by the CPU
+	std::uint32_t static collisionMask(const OrientedBoundingBox& OBB1, const BoxBatch& batch, int first, int count, SimdLevel level);
+
+	// True if OBB1 collides with any box in the batch
+	bool static collidesWithAny(const OrientedBoundingBox& OBB1, const BoxBatch& batch);
+
+	// The fastest instruction set this CPU supports, detected on first use
+	SimdLevel static simdLevel();
 };
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "NavGrid.h"
+
+/// <summary>
+/// @brief The shortest way to one goal from every cell of a NavGrid.
+///
+/// A single Dijkstra search spreads out from the goal cell and leaves each walkable cell
+///  pointing at its neighbour that is one step nearer the goal. Any number of tanks
+///  heading for the same goal then only look up their own cell, so the cost stays the
+///  same however many are chasing. The field is only rebuilt when the goal moves into
+///  another cell, the first time a direction is asked for after that.
+/// direction() rebuilds the field lazily, so it is not const: call refresh() after setGoal()
+///  and before direction() is used from several threads, such as the steering threads.
+/// Example usage:
+///		flowField.setGoal(playerPos);
+///		flowField.refresh();
+///		sf::Vector2f heading;
+///		if (flowField.direction(tankPos, heading)) { ... }
+/// </summary>
+class FlowField
+{
+public:
+	explicit FlowField(NavGrid const& t_grid);
+
+	// moves the goal, the field is rebuilt on the next lookup if it moved into another cell
+	void setGoal(sf::Vector2f t_goal);
+
+	// builds the field now if the goal has moved. Until the goal moves again, direction() only
+	// reads the field and can be called from several threads at once
+	void refresh();
+
+	/// <summary>
+	/// @brief Which way to go from a position to reach the goal.
+	/// </summary>
+	/// <param name="t_position">Where the tank is</param>
+	/// <param name="t_direction">Set to a vector from the position to the centre of the next cell on the way</param>
+	/// <returns>False if the goal can not be reached from the position's cell.</returns>
+	bool direction(sf::Vector2f t_position, sf::Vector2f& t_direction);
+
+	// the number of times the field has been built, for profiling
+	int builds() const;
+
+private:
+	void build();
+
+	struct OpenNode
+	{
+		float m_distance;
+		int m_cell;
+	};
+
+	static bool worse(OpenNode const& t_a, OpenNode const& t_b);
+
+	NavGrid const& m_grid;
+
+	int m_goalCell = -1;
+	bool m_dirty = true;
+
+	// travel cost from each cell to the goal, and the neighbour to go to next (-1 if unreachable)
+	std::vector<float> m_distance;
+	std::vector<int> m_next;
+
+	std::vector<OpenNode> m_open;
+
+	int m_builds = 0;
+};
@@ -2,16 +2,17 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include <memory>
 #include "ScreenSize.h"
-#include "LevelLoader.h"
-#include "Tank.h"
-#include "TankAI.h"
-#include "Bullet.h"
-#include "Thor/Time.hpp"
-#include "Globals.h"
+#include "World.h"
+#include "ThreadPool.h"
+#include "StaticLayer.h"
+#include "TextureAtlas.h"
+#include "SpriteBatch.h"
+#include "KeyboardInput.h"
+#include "ReplayRecorder.h"
 #include "GameState.h"
 #include "HUD.h"
-#include "cargoMode.h"
 
 /// <summary>
 /// @author Stephen Hurley
@@ -34,38 +35,37 @@ class Game
 public:
 
 	/// <summary>
-	/// @brief Default constructor that initialises the SFML window, 
+	/// @brief Constructor that initialises the SFML window, 
 	///   and sets vertical sync enabled. 
 	/// </summary>
-	/// 
-	Game();
+	/// <param name="t_seed">Seed for the world, the same seed gives the same target layout and AI patrols</param>
+	Game(std::uint64_t t_seed);
 
 	/// <summary>
 	/// @brief the main game loop.
 	/// 
 	/// A complete loop involves processing SFML events, updating and drawing all game objects.
-	/// The actual elapsed time for a single game loop results (lag) is stored. If this value is 
-	///  greater than the notional time for one loop (MS_PER_UPDATE), then additional updates will be 
-	///  performed until the lag is less than the notional time for one loop.
-	/// The target is one update and one render cycle per game loop, but slower PCs may 
-	///  perform more update than render operations in one loop.
+	/// The actual elapsed time for a single game loop is added to the lag. The simulation is then
+	///  advanced in fixed steps of MS_PER_UPDATE until the lag is less than one step, so the
+	///  simulation behaves the same at any frame rate. At most MAX_UPDATES_PER_FRAME steps are
+	///  run per loop; any lag beyond that is dropped so slow PCs do not fall further and further behind.
+	/// The lag left over is used to draw moving objects part way between the last two steps.
 	/// </summary>
 	void run();
 
 protected:
 	/// <summary>
-	/// @brief Placeholder to perform updates to all game objects.
+	/// @brief Advances the game by one fixed simulation step.
 	/// </summary>
-	/// <param name="time">update delta time</param>
+	/// <param name="time">update delta time, always MS_PER_UPDATE</param>
 	void update(double dt);
 
 	/// <summary>
 	/// @brief Draws the background and foreground game objects in the SFML window.
 	/// The render window is always cleared to black before anything is drawn.
 	/// </summary>
-	void render();
-
-	void renderTargets();
+	/// <param name="alpha">How far the frame is between the previous and current step (0 to 1)</param>
+	void render(float alpha);
 
 	/// <summary>
 	/// @brief Checks for events.
@@ -80,30 +80,22 @@ protected:
 	/// <param name="event">system event</param>
 	void processGameEvents(sf::Event&);
 
-	/// <summary>
-/// @brief Creates the wall sprites and loads them into a vector.
-/// Note that sf::Sprite is considered a light weight class, so 
-///  storing copies (instead of pointers to sf::Sprite) in std::vector is acceptable.
-/// </summary>
-	void generateWalls();
+	// fills m_input from the keyboard state, done once per frame before any updates
+	void readInput();
 
-	// generates targets and loads them into a vector like generateWalls() does with wall sprites
-	void generateTargets();
+	// plays the sounds for the events raised by the last simulation step
+	void playEventSounds();
 
-	//check remaining time of current target. if it has less than 5 seconds of being active,
-	// display its countdown 
-	void remainingTargetTime(int i);
-	// check if target was shot. If it was, reset timer with the remaining time of the previous target added on as reward
-	void targetShot(int i);
-	// check if target has expired (time to shoot it has run out) if it was, spawn next target
-	void genNextTarget(int i);
+	// starts or pauses the tank moving sound to match whether the player tank is moving
+	void tankMovingSoundControl();
 
-	void setUpFontAndText();
+	// loads the images for the world sprites and packs them into an atlas
+	static TextureAtlas loadTextures();
 
-	// updates the gameTimer text
-	void updateGameTimer();
+	// points the targets, pickups and goal at their images in the atlas
+	void setWorldTextures();
 
-	int m_timeRemaining;
+	void setUpFontAndText();
 
 	void setUpEndScreen();
 
@@ -116,30 +108,45 @@ protected:
 	// load and set up sounds
 	void initSounds();
 	
-	LevelData m_level;
+	// the sprite sheet, targets, fuel pickup, base goal and cargo pickup images packed into as
+	// few textures as possible, declared before the world as it refers to the pages
+	TextureAtlas m_atlas;
+
+	// runs the AI path searches alongside the simulation, declared before the world so it outlives it
+	ThreadPool m_pathThreads{ 1 };
+
+	// steers the AI tanks in parallel. Kept apart from the path threads, as the world waits for
+	// this pool to finish every step while path searches run on across steps
+	ThreadPool m_aiThreads;
+
+	// the simulation, owns all of the game objects
+	World m_world;
 
-	// An instance representing the player controlled tank.
-	Tank m_tank;
+	// the held keys, updated from window events
+	KeyboardInput m_keyboard;
 
-	// instance representing ai controlled tank
-	TankAi m_aiTank;
+	// the player input for the current frame
+	InputCommand m_input;
 
-	// instance representing fuel pickup, base goal and cargo pickup
-	cargoMode m_cargoMode;
+	// records every session to ./replays/<seed>.tkr so it can be reproduced later
+	std::unique_ptr<ReplayRecorder> m_replay;
 
-	// sprites for obstacles
-	std::vector<sf::Sprite> m_wallSprites;
-	// A texture for the sprite sheet
-	sf::Texture m_texture;
+	// when paused no simulation steps are run, P toggles
+	bool m_paused = false;
+
+	// simulated time per real time, F toggles fast forward
+	double m_timeScale = 1.0;
+	static constexpr double FAST_FORWARD_SCALE = 4.0;
 
 	// texture and sprite for background
 	sf::Texture m_bgTexture; 
 	sf::Sprite m_bgSprite;
 
-	// sprites for targets
-	std::vector<sf::Sprite> m_targetSprites;
-	// A texture for the sprite sheet
-	sf::Texture m_targetTexture;
+	// collects the world's sprites each frame and draws them in as few draw calls as possible
+	SpriteBatch m_spriteBatch;
+
+	// the background and walls, drawn once into render textures
+	StaticLayer m_staticLayer;
 
 	// main window
 	sf::RenderWindow m_window;
@@ -148,9 +155,6 @@ protected:
 	sf::Text m_gameOverText;
 	sf::Font m_font;
 
-	// string containing current objective
-	std::string m_objectiveString = "Collect the Ammo!";
-
 	// sound for target being hit by bullet
 	sf::SoundBuffer m_targetHitBuffer;
 	sf::Sound m_targetHitSound;
@@ -159,35 +163,30 @@ protected:
 	sf::SoundBuffer m_targetAppearBuffer;
 	sf::Sound m_targetAppearSound;
 
-	// text used to display how much time a target has remaining
-	sf::Text m_targetTimerText;
-	int m_remainingTime;
+	// sound for the player tank firing
+	sf::SoundBuffer m_tankFiringBuffer;
+	sf::Sound m_tankFiringSound;
 
-	// timer used for in game time, where upon reaching 0 the game is over
-	// timer is in seconds 
-	thor::Timer m_timer;
-	static constexpr float TIMER_DURATION = 60.0f;
+	// looping sound for the player tank moving
+	sf::SoundBuffer m_tankMovingBuffer;
+	sf::Sound m_tankMovingSound;
+	bool m_toggleMovingSound = false;
 
-	// timer used for targets, in seconds
-	thor::Timer m_targetTimer;
+	// sound for a bullet hitting a wall
+	sf::SoundBuffer m_wallHitBuffer;
+	sf::Sound m_wallHitSound;
 
-	// control when to display indictator of target about to vanish
-	bool m_targetVanishing = false;
+	// text used to display how much time a target has remaining
+	sf::Text m_targetTimerText;
 
 	// ensures read and writing to file only happens once
 	bool m_readAndWrite = false;
 
-	int m_playerScore = 0;
 	int m_highestPlayerScore = 0;
 
 	float m_highestTargetsHit = 0;
-	float m_targetsHit = 0;
 
 	float m_accuracyOfHighScore = 0;
-	float m_accuracy = 0;
-
-	// The initial game state set to GAME_RUNNING
-	GameState m_gameState{ GameState::GAME_RUNNING };
 
 	HUD m_hud;
 };
@@ -1,12 +1,16 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include "GameState.h"
 
 /// <summary>
 /// @brief A basic HUD implementation.
-/// 
+///
 /// Shows current game state only.
+/// The labels and the background never change, so they are drawn once into a texture on the
+///  first render(). Each value remembers what it last showed and its text is only laid out
+///  again when that changes, so a tick where nothing changed costs a few comparisons.
 /// </summary>
 
 class HUD
@@ -14,14 +18,15 @@ class HUD
 public:
 	/// <summary>
 	/// @brief Default constructor that stores a font for the HUD and initialises the general HUD appearance.
+	/// The font does not need to be loaded until the HUD is first drawn.
 	/// </summary>
 	HUD(sf::Font& hudFont);
 
 	/// <summary>
-	/// @brief Checks the current game state and sets the appropriate status text on the HUD.
+	/// @brief Checks the current game state and values and updates the HUD text that changed.
 	/// </summary>
 	/// <param name="gameState">The current game state</param>
-	void update(GameState const& gameState, int t_gameTimeRemaining, int t_fuelRemaining, int t_score, std::string objectiveText);
+	void update(GameState const& gameState, int t_gameTimeRemaining, int t_fuelRemaining, int t_score, std::string const& t_objectiveText);
 
 	/// <summary>
 	/// @brief Draws the HUD outline and text.
@@ -31,20 +36,46 @@ public:
 	void render(sf::RenderWindow& window);
 
 private:
+	// sets the look shared by all the HUD text
+	void setUpText(sf::Text& t_text, sf::Font& t_font, sf::Vector2f t_position, sf::String const& t_string);
+
+	// draws the background and labels into m_labelTexture and puts each value after its label
+	void prerenderLabels();
+
+	// sets a value's text to a number if it is not already showing it
+	static void showNumber(sf::Text& t_text, int& t_shown, int t_value);
+
 	// The font for this HUD.
 	sf::Font m_textFont;
 
 	// A container for the current gamestate text.
 	sf::Text m_gameStateText;
+	GameState m_shownGameState = GameState::GAME_RUNNING;
 
+	// the fixed labels, only drawn into m_labelTexture
+	sf::Text m_fuelLabel;
+	sf::Text m_timerLabel;
+	sf::Text m_objectiveLabel;
+	sf::Text m_scoreLabel;
+
+	// the values shown after the labels, and the values they show
 	sf::Text m_fuelText;
+	int m_shownFuel;
 
 	sf::Text m_timerText;
+	int m_shownTime;
 
 	sf::Text m_objectiveText;
+	std::string m_shownObjective;
 
 	sf::Text m_scoreText;
+	int m_shownScore;
 
 	// A simple background shape for the HUD.
 	sf::RectangleShape m_hudOutline;
-};
\ No newline at end of file
+
+	// the background and labels, drawn on the first render once the font is loaded
+	std::unique_ptr<sf::RenderTexture> m_labelTexture;
+	sf::Sprite m_labelSprite;
+	bool m_labelsDrawn = false;
+};
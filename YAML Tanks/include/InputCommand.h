@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+/// <summary>
+/// @brief The player controls for a single simulation tick.
+///
+/// Filled once per frame by an InputSource (the keyboard in Game, a bot or a recording
+///  in the headless runners) and passed into World::step(). The tank and its bullets
+///  read nothing else, so the same stream of commands always drives the same match.
+/// Each axis is -1, 0 or +1.
+/// </summary>
+struct InputCommand
+{
+	// -1 slows down / reverses, +1 speeds up
+	std::int8_t m_throttle = 0;
+
+	// -1 turns the base anticlockwise (left), +1 clockwise (right)
+	std::int8_t m_steer = 0;
+
+	// -1 turns the turret anticlockwise (left), +1 clockwise (right)
+	std::int8_t m_turret = 0;
+
+	bool m_fire = false;
+
+	// swings the turret back in line with the base
+	bool m_centreTurret = false;
+
+	/// <summary>
+	/// @brief Combines a pair of opposing controls into a single axis value.
+	/// Both or neither held gives 0.
+	/// </summary>
+	/// <param name="t_negative">The control for the -1 direction</param>
+	/// <param name="t_positive">The control for the +1 direction</param>
+	/// <returns>-1, 0 or +1.</returns>
+	static std::int8_t axis(bool t_negative, bool t_positive)
+	{
+		return static_cast<std::int8_t>((t_positive ? 1 : 0) - (t_negative ? 1 : 0));
+	}
+
+	bool operator==(InputCommand const& t_other) const
+	{
+		return m_throttle == t_other.m_throttle && m_steer == t_other.m_steer && m_turret == t_other.m_turret
+			&& m_fire == t_other.m_fire && m_centreTurret == t_other.m_centreTurret;
+	}
+
+	bool operator!=(InputCommand const& t_other) const
+	{
+		return !(*this == t_other);
+	}
+};
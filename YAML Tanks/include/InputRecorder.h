@@ -0,0 +1,33 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include "InputSource.h"
+
+/// <summary>
+/// @brief Passes on the input of another source and saves every command to a file.
+///
+/// The file can be played back with RecordedInput. Together with the world seed this
+///  is enough to replay a match exactly.
+/// Example usage:
+///		PlayerBot bot(PlayerBot::Mode::AI);
+///		InputRecorder recorder(bot, "match.txt");
+///		world.step(10.0, recorder.nextInput(world));
+/// </summary>
+class InputRecorder : public InputSource
+{
+public:
+	/// <summary>
+	/// @brief Opens the file the input is saved to, an exception is thrown if it can not be created.
+	/// </summary>
+	/// <param name="t_source">The source being recorded, must outlive the recorder</param>
+	/// <param name="t_fileName">The file to write</param>
+	InputRecorder(InputSource& t_source, std::string const& t_fileName);
+
+	InputCommand nextInput(World const& t_world) override;
+
+private:
+	InputSource& m_source;
+
+	std::ofstream m_outputFile;
+};
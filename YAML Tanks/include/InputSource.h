@@ -0,0 +1,25 @@
+#pragma once
+
+#include "InputCommand.h"
+
+class World;
+
+/// <summary>
+/// @brief Anything that can drive the player tank.
+///
+/// Asked once per simulation tick for the next command. Implemented by the keyboard,
+///  the player bot and recorded input files, and by InputRecorder which wraps any of
+///  them and saves what it produces.
+/// </summary>
+class InputSource
+{
+public:
+	virtual ~InputSource() = default;
+
+	/// <summary>
+	/// @brief Produces the player input for the next step.
+	/// </summary>
+	/// <param name="t_world">The world being played, for sources that react to it</param>
+	/// <returns>The input for the next step.</returns>
+	virtual InputCommand nextInput(World const& t_world) = 0;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SFML/Window/Event.hpp>
+#include "InputSource.h"
+
+/// <summary>
+/// @brief Player input from the keyboard, built from SFML key events.
+///
+/// Key pressed and released events are fed in as they are polled, so the keyboard
+///  is never queried from inside the simulation loop.
+/// Controls: Up/Down throttle, Left/Right steer, Z/X turret, C centres the turret,
+///  Space fires.
+/// </summary>
+class KeyboardInput : public InputSource
+{
+public:
+	/// <summary>
+	/// @brief Updates the held keys from a window event.
+	/// All keys are released when the window loses focus, as the release events
+	///  would otherwise never arrive.
+	/// </summary>
+	/// <param name="t_event">An event polled from the window</param>
+	void handleEvent(sf::Event const& t_event);
+
+	InputCommand nextInput(World const& t_world) override;
+
+private:
+	void setKey(sf::Keyboard::Key t_key, bool t_down);
+
+	bool m_up = false;
+	bool m_down = false;
+	bool m_left = false;
+	bool m_right = false;
+	bool m_turretLeft = false;
+	bool m_turretRight = false;
+	bool m_centreTurret = false;
+	bool m_fire = false;
+};
@@ -4,7 +4,8 @@
 #include <vector>
 #include <fstream>
 #include <iostream>
-#include "yaml-cpp\yaml.h"
+#include "yaml-cpp/yaml.h"
+#include "Random.h"
 
 /// <summary>
 /// @brief A struct to represent Obstacle data in the level.
@@ -22,6 +23,8 @@ struct TargetData
 	std::string m_type;
 	sf::Vector2f m_position;
 	int m_duration;
+	// the position is moved by a random amount up to this in each direction when the level is loaded
+	int m_maxOffSet;
 	bool m_active;
 	bool m_removedFromGame;
 	bool m_shot;
@@ -48,13 +51,13 @@ struct TankData
 /// <summary>
 /// @brief A struct representing all the Level Data.
 /// 
-/// Obstacles may be repeated and are therefore stored in a container.
+/// Obstacles, targets and AI tanks may be repeated and are therefore stored in containers.
 /// </summary>
 struct LevelData
 {
 	BackgroundData m_background;
 	TankData m_tank;
-	TankData m_aiTank;
+	std::vector<TankData> m_aiTanks;
 	std::vector<ObstacleData> m_obstacles;
 	std::vector<TargetData> m_targets;
 };
@@ -82,8 +85,11 @@ public:
 	/// The level information is stored in the specified LevelData object.
 	/// If the filename is not found or the file data is invalid, an exception
 	/// is thrown.
+	/// Target positions are offset using the supplied generator, so the same seed
+	/// always gives the same level.
 	/// </summary>
 	/// <param name="t_levelNr">The level number</param>
 	/// <param name="t_level">A reference to the LevelData object</param>
-	static void load(int t_levelNr, LevelData& t_level);
+	/// <param name="t_random">The random number generator of the world being loaded</param>
+	static void load(int t_levelNr, LevelData& t_level, Random& t_random);
 };
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "Raycaster.h"
+
+/// <summary>
+/// @brief A vision cone looking for something, one entry of a batched visibility check.
+/// </summary>
+struct SightQuery
+{
+	// where the observer looks from
+	sf::Vector2f m_eye;
+
+	// unit vector along the middle of the cone
+	sf::Vector2f m_facing;
+
+	// how far the cone reaches in pixels
+	float m_range = 0.0f;
+
+	// angle between the middle and either edge of the cone, in degrees (below 90)
+	float m_halfAngle = 0.0f;
+};
+
+/// <summary>
+/// @brief Visibility checks for the AI vision cones that take walls into account.
+///
+/// Each query is rejected by distance and then by angle, which costs a few multiplies,
+///  and only the observers that pass both cast a ray, which walks just the wall grid
+///  cells between the eye and the target.
+/// Example usage:
+///		lineOfSight.beginStep();
+///		lineOfSight.canSee(queries.data(), queries.size(), playerPos, results.data());
+/// </summary>
+class LineOfSight
+{
+public:
+	// counts of how the checks since the last beginStep() were answered
+	struct Stats
+	{
+		int m_queries = 0;
+		int m_rejectedByDistance = 0;
+		int m_rejectedByAngle = 0;
+		int m_raysCast = 0;
+	};
+
+	explicit LineOfSight(Raycaster const& t_raycaster);
+
+	// starts counting the checks of a new step, called at the start of every step
+	void beginStep();
+
+	/// <summary>
+	/// @brief Checks which of a batch of vision cones can see a point.
+	/// </summary>
+	/// <param name="t_queries">The cones to check</param>
+	/// <param name="t_count">Number of cones</param>
+	/// <param name="t_target">The point looked for, usually the player's position</param>
+	/// <param name="t_results">Set to true for each cone the point is inside with no wall in the way</param>
+	void canSee(SightQuery const* t_queries, int t_count, sf::Vector2f t_target, bool* t_results);
+
+	// the same check for a single cone
+	bool canSee(SightQuery const& t_query, sf::Vector2f t_target);
+
+	Stats const& stats() const;
+
+private:
+	Raycaster const& m_raycaster;
+
+	// observers that passed the distance and angle tests, reused by every batch
+	std::vector<int> m_candidates;
+
+	Stats m_stats;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// @brief A read only view of a whole file mapped into memory.
+///
+/// Lets the replay player jump to any keyframe without reading the file up to it.
+/// Uses mmap on Linux and a file mapping on Windows. An exception is thrown if the
+///  file can not be opened or mapped.
+/// </summary>
+class MappedFile
+{
+public:
+	explicit MappedFile(std::string const& t_fileName);
+	~MappedFile();
+
+	MappedFile(MappedFile const&) = delete;
+	MappedFile& operator=(MappedFile const&) = delete;
+
+	std::uint8_t const* data() const;
+	std::size_t size() const;
+
+private:
+	std::uint8_t const* m_data = nullptr;
+	std::size_t m_size = 0;
+
+	// platform handles, the file and (on Windows) its mapping object
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+};
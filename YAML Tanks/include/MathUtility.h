@@ -17,13 +17,32 @@ namespace MathUtility
 	/// <returns>The length of the line between v1 and v2.</returns>
 	double distance(sf::Vector2f v1, sf::Vector2f v2);
 
+	/// <summary>
+	/// @brief Returns the squared distance between two points, for comparing distances without a square root.
+	/// </summary>
+	/// <param name="v1">An x,y world position</param>
+	/// <param name="v2">An x,y world position</param>
+	/// <returns>The squared length of the line between v1 and v2.</returns>
+	float distanceSquared(sf::Vector2f v1, sf::Vector2f v2);
+
 	/// <summary>
 	/// @brief Returns true if either of the supplied points are inside the radius of the specified circle. 
 	/// </summary>
 	/// <param name="ahead">The ahead vector of the tank</param>
 	/// <param name="halfAhead">Assumed to be half the length of the ahead vector</param>
+	/// <param name="circle">The circle to test</param>
 	/// <returns>true if either vector is inside the radius of the specified circle.</returns>
-	bool lineIntersectsCircle(sf::Vector2f ahead, sf::Vector2f halfAhead, sf::CircleShape circle);
+	bool lineIntersectsCircle(sf::Vector2f ahead, sf::Vector2f halfAhead, sf::CircleShape const& circle);
+
+	/// <summary>
+	/// @brief The same test for a circle given by its centre and squared radius.
+	/// </summary>
+	/// <param name="ahead">The ahead vector of the tank</param>
+	/// <param name="halfAhead">Assumed to be half the length of the ahead vector</param>
+	/// <param name="center">The centre of the circle</param>
+	/// <param name="radiusSq">The radius of the circle, squared</param>
+	/// <returns>true if either vector is inside the circle.</returns>
+	bool lineIntersectsCircle(sf::Vector2f ahead, sf::Vector2f halfAhead, sf::Vector2f center, float radiusSq);
 
 	/// <summary>
 	/// @brief Truncates the supplied vector so that its length is not greater than the specified number. 
@@ -34,4 +53,23 @@ namespace MathUtility
 	/// <returns>A vector whose length is not longer than the specified maximum.</returns>
 	sf::Vector2f truncate(sf::Vector2f v, float const max);
 
+	/// <summary>
+	/// @brief Linearly interpolates between two points.
+	/// </summary>
+	/// <param name="from">The point at alpha 0</param>
+	/// <param name="to">The point at alpha 1</param>
+	/// <param name="alpha">The blend factor, in the range 0 to 1</param>
+	/// <returns>The interpolated point.</returns>
+	sf::Vector2f lerp(sf::Vector2f from, sf::Vector2f to, float alpha);
+
+	/// <summary>
+	/// @brief Interpolates between two angles in degrees, taking the shortest way round
+	///  so that a wrap from 359 to 0 degrees does not spin the whole way back.
+	/// </summary>
+	/// <param name="from">The angle at alpha 0</param>
+	/// <param name="to">The angle at alpha 1</param>
+	/// <param name="alpha">The blend factor, in the range 0 to 1</param>
+	/// <returns>The interpolated angle in degrees.</returns>
+	float lerpAngle(float from, float to, float alpha);
+
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "StaticColliders.h"
+
+/// <summary>
+/// @brief A grid of walkable and blocked cells over the level, for AI path finding.
+///
+/// Baked once from the wall boxes when the level is built. A cell is blocked if a square
+///  the size of the cell grown by the clearance on every side touches a wall, so a tank
+///  following the cell centres keeps that far away from the walls.
+/// Cells are numbered row by row, index = row * columns() + column.
+/// Example usage:
+///		NavGrid navGrid;
+///		navGrid.build(walls, 1440, 900, 16.0f, 12.0f);
+///		int start = navGrid.cellOf(tankPos);
+/// </summary>
+class NavGrid
+{
+public:
+	/// <summary>
+	/// @brief Marks the cells that are too close to a wall as blocked.
+	/// </summary>
+	/// <param name="t_walls">The baked wall boxes and their broad phase grid</param>
+	/// <param name="t_width">Width of the area covered, from 0, in pixels</param>
+	/// <param name="t_height">Height of the area covered, from 0, in pixels</param>
+	/// <param name="t_cellSize">Width and height of a cell in pixels</param>
+	/// <param name="t_clearance">How far the cell centres must stay from the walls in pixels, at least half a cell</param>
+	void build(StaticColliders const& t_walls, int t_width, int t_height, float t_cellSize, float t_clearance);
+
+	// the cell containing a position, clamped to the grid
+	int cellOf(sf::Vector2f t_position) const;
+
+	sf::Vector2f cellCentre(int t_cell) const;
+
+	bool walkable(int t_cell) const;
+
+	// true if both cells are walkable and every cell a straight line between their centres crosses is too
+	bool clearLine(int t_from, int t_to) const;
+
+	// the walkable cell nearest to a cell, searching outwards ring by ring; -1 if none is walkable
+	int nearestWalkable(int t_cell) const;
+
+	int columns() const;
+	int rows() const;
+	int size() const;
+	float cellSize() const;
+
+private:
+	float m_cellSize = 16.0f;
+	int m_columns = 0;
+	int m_rows = 0;
+
+	// one entry per cell, 1 if a tank can drive through it
+	std::vector<unsigned char> m_walkable;
+};
@@ -14,12 +14,30 @@
 ///https://github.com/SFML/SFML/wiki/Source:-Simple-Collision-Detection-for-SFML-2
 /// </summary>
 
+/// The box also keeps its two edge axes and its own projection onto each of them, so a
+///  box built once for an object that never moves (a wall, a pickup) can be tested again
+///  and again without recomputing anything on its side. The whole box is 64 bytes.
 class OrientedBoundingBox // Used in the BoundingBoxTest
 {
 public:
+	OrientedBoundingBox() = default;
+
 	OrientedBoundingBox(const sf::Sprite& Object); // Calculate the four points of the OBB from a transformed (scaled, rotated...) RectangleShape
 
+	explicit OrientedBoundingBox(const sf::FloatRect& Rect); // A box that is not rotated, e.g. a navigation grid cell
+
+	void set(const sf::Sprite& Object); // Recalculate the points, axes and intervals, e.g. after the sprite has moved
+
 	sf::Vector2f Points[4];
 
-	void ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max); // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
+	// Edge directions, Points[1] - Points[0] and Points[1] - Points[2]
+	sf::Vector2f Axes[2];
+
+	// Projection of the box onto each of its own axes
+	float AxisMin[2] = { 0.f, 0.f };
+	float AxisMax[2] = { 0.f, 0.f };
+
+	void ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max) const; // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
+
+	sf::FloatRect getBounds() const; // The axis aligned rectangle around the four points, for broad phase queries
 };
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "NavGrid.h"
+
+/// <summary>
+/// @brief A* search over a NavGrid.
+///
+/// Moves in 8 directions, never cutting the corner of a blocked cell, with the octile
+///  distance as the heuristic. The open list is a binary heap kept in a vector, and the
+///  per cell costs are reused between searches, marked stale by a search counter instead
+///  of being cleared, so a search only touches the cells it visits.
+/// Example usage:
+///		PathFinder pathFinder;
+///		std::vector<sf::Vector2f> path;
+///		if (pathFinder.findPath(navGrid, tankPos, playerPos, path)) ...
+/// </summary>
+class PathFinder
+{
+public:
+	/// <summary>
+	/// @brief Finds a path between two points.
+	/// A start or goal inside a blocked cell is moved to the nearest walkable cell. The
+	///  path is shortened by dropping every waypoint that can be skipped in a straight line.
+	/// </summary>
+	/// <param name="t_grid">The navigation grid to search</param>
+	/// <param name="t_start">Where the path starts</param>
+	/// <param name="t_goal">Where the path should end</param>
+	/// <param name="t_path">Cleared, then filled with the cell centres to drive through, ending at the goal cell</param>
+	/// <returns>True if the goal can be reached.</returns>
+	bool findPath(NavGrid const& t_grid, sf::Vector2f t_start, sf::Vector2f t_goal, std::vector<sf::Vector2f>& t_path);
+
+	// number of cells expanded by the last search
+	int expanded() const;
+
+private:
+	struct OpenNode
+	{
+		float m_estimate; // cost so far plus the heuristic
+		int m_cell;
+	};
+
+	// heap order, lowest estimate first, ties broken by cell so every platform pops the same cell
+	static bool worse(OpenNode const& t_a, OpenNode const& t_b);
+
+	std::vector<OpenNode> m_open;
+
+	// best cost found to each cell and the cell it was reached from, valid when m_seen matches m_search
+	std::vector<float> m_cost;
+	std::vector<int> m_parent;
+	std::vector<unsigned> m_seen;
+	std::vector<unsigned> m_closed;
+	unsigned m_search = 0;
+
+	// the cells of the raw path, reused between searches
+	std::vector<int> m_cells;
+
+	int m_expanded = 0;
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <deque>
+#include <vector>
+#include "NavGrid.h"
+#include "PathFinder.h"
+#include "StateStream.h"
+#include "ThreadPool.h"
+
+/// <summary>
+/// @brief Path requests from the AI tanks, searched off the main thread.
+///
+/// A request made during step N waits in a queue. At the start of a later step, update()
+///  sends at most MAX_SEARCHES_PER_STEP of the oldest waiting requests to the thread pool,
+///  where they run while the rest of that step is simulated. Their paths are collected
+///  and handed out at the start of the step after that, so many tanks re-targeting at
+///  once are spread over several steps instead of stalling one.
+/// A new request from a tank replaces the one it still has waiting, and a result that
+///  was overtaken by a newer request is dropped, so only the latest goal is ever searched
+///  for and delivered.
+/// When each path arrives depends only on the order of requests, never on how quickly
+///  the threads run, so matches replay the same with or without a pool. Without one the
+///  searches run on the calling thread inside update().
+/// Example usage:
+///		int ticket = paths.addRequester();
+///		paths.request(ticket, tankPos, playerPos);
+///		...
+///		paths.update();	// once at the start of every step
+///		if (paths.takeResult(ticket, path)) ...
+/// </summary>
+class PathQueue
+{
+public:
+	// counts since the queue was created
+	struct Stats
+	{
+		int m_requested = 0;
+		int m_coalesced = 0;
+		int m_searched = 0;
+		int m_delivered = 0;
+		int m_dropped = 0;
+	};
+
+	// the most searches started in one step
+	static constexpr int MAX_SEARCHES_PER_STEP = 4;
+
+	explicit PathQueue(NavGrid const& t_grid);
+
+	// waits for any searches still running, they refer to the queue
+	~PathQueue();
+
+	PathQueue(PathQueue const&) = delete;
+	PathQueue& operator=(PathQueue const&) = delete;
+
+	/// <summary>
+	/// @brief Runs the searches on a thread pool from now on.
+	/// The pool must outlive the queue, and should not be waited on by anything else
+	///  while the queue has searches in it.
+	/// </summary>
+	/// <param name="t_pool">The pool to use, nullptr runs searches on the calling thread</param>
+	void setThreadPool(ThreadPool* t_pool);
+
+	// registers a tank that will ask for paths, returns the ticket it makes requests with
+	int addRequester();
+
+	/// <summary>
+	/// @brief Asks for a path. Replaces the requester's earlier request if it has not been searched yet.
+	/// </summary>
+	/// <param name="t_requester">Ticket from addRequester()</param>
+	/// <param name="t_start">Where the path starts</param>
+	/// <param name="t_goal">Where the path should end</param>
+	void request(int t_requester, sf::Vector2f t_start, sf::Vector2f t_goal);
+
+	/// <summary>
+	/// @brief Hands out the path for the requester's latest request, if it arrived this step.
+	/// </summary>
+	/// <param name="t_requester">Ticket from addRequester()</param>
+	/// <param name="t_path">Set to the waypoints, empty if the goal can not be reached</param>
+	/// <returns>True if a path arrived, false leaves t_path alone.</returns>
+	bool takeResult(int t_requester, std::vector<sf::Vector2f>& t_path);
+
+	// collects the searches started last step and starts the next ones, once at the start of every step
+	void update();
+
+	// saves and restores the waiting and running requests, for replay keyframes
+	void saveState(StateWriter& t_writer) const;
+	void loadState(StateReader& t_reader);
+
+	Stats const& stats() const;
+
+private:
+	struct Request
+	{
+		int m_requester;
+		unsigned m_serial;
+		sf::Vector2f m_start;
+		sf::Vector2f m_goal;
+	};
+
+	struct Search
+	{
+		Request m_request;
+		std::vector<sf::Vector2f> m_path;
+	};
+
+	struct Requester
+	{
+		// serial of the requester's latest request, older results are dropped
+		unsigned m_latest = 0;
+
+		bool m_ready = false;
+		std::vector<sf::Vector2f> m_result;
+	};
+
+	// starts the searches in m_running, on the pool if there is one
+	void startSearches();
+
+	// waits for the searches in m_running to finish
+	void finishSearches();
+
+	NavGrid const& m_grid;
+	ThreadPool* m_pool = nullptr;
+
+	std::deque<Request> m_waiting;
+
+	// the searches started this step, m_finders[i] is used by m_running[i]
+	std::vector<Search> m_running;
+	std::vector<PathFinder> m_finders;
+
+	std::vector<Requester> m_requesters;
+
+	Stats m_stats;
+};
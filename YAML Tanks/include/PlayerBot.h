@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include "InputSource.h"
+
+/// <summary>
+/// @brief Drives the player tank without a keyboard.
+///
+/// Used by the headless and batch runners. In SCRIPTED mode it plays back a fixed
+///  pattern of inputs; in AI mode it reads the world and plays the objective: it picks up
+///  fuel when running low, collects the ammo, delivers it to the base and shoots any
+///  active target it can aim at on the way.
+/// </summary>
+class PlayerBot : public InputSource
+{
+public:
+	enum class Mode
+	{
+		SCRIPTED,
+		AI
+	};
+
+	explicit PlayerBot(Mode t_mode);
+
+	/// <summary>
+	/// @brief Works out the player input for the next step.
+	/// </summary>
+	/// <param name="t_world">The world the bot is playing in</param>
+	/// <returns>The input for the next step.</returns>
+	InputCommand nextInput(World const& t_world) override;
+
+private:
+	InputCommand scriptedInput() const;
+
+	InputCommand aiInput(World const& t_world);
+
+	// the point the tank base should drive towards
+	sf::Vector2f currentGoal(World const& t_world) const;
+
+	// signed difference between two angles in degrees, in the range -180 to 180
+	static float angleDifference(float t_from, float t_to);
+
+	Mode m_mode;
+
+	// number of inputs produced so far
+	long m_tick = 0;
+
+	// stuck detection, position when last checked
+	sf::Vector2f m_lastCheckPosition;
+
+	// ticks left to reverse out of a wall
+	int m_reverseTicks = 0;
+
+	// fuel level below which the bot goes for the fuel pickup
+	static constexpr double LOW_FUEL = 1500.0;
+
+	// how often the bot checks if it is stuck, in ticks
+	static constexpr int STUCK_CHECK_TICKS = 100;
+
+	// how far it must have moved between checks to not be stuck
+	static constexpr float STUCK_DISTANCE = 5.0f;
+
+	// how long it reverses once stuck, in ticks
+	static constexpr int REVERSE_TICKS = 60;
+
+	// base and turret angle error that counts as lined up, in degrees
+	static constexpr float DRIVE_TOLERANCE = 45.0f;
+	static constexpr float AIM_TOLERANCE = 4.0f;
+
+	// only fire at targets closer than this
+	static constexpr float FIRING_RANGE = 700.0f;
+};
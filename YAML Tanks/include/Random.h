@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+/// <summary>
+/// @brief A small, fast, seedable random number generator (xoshiro128**).
+///
+/// Each World owns one, seeded from its match seed, and passes it to everything that
+///  needs randomness (level loading, AI patrols). Unlike the global rand(), two worlds
+///  never share state, so worlds can run on different threads and a match can be
+///  replayed exactly from its seed.
+/// </summary>
+class Random
+{
+public:
+	/// <summary>
+	/// @brief Seeds the generator. The four words of state are filled from the seed
+	///  with splitmix64, so nearby seeds still give unrelated sequences.
+	/// </summary>
+	/// <param name="t_seed">Any seed value</param>
+	explicit Random(std::uint64_t t_seed = 0);
+
+	void seed(std::uint64_t t_seed);
+
+	// the next 32 random bits
+	std::uint32_t next();
+
+	/// <summary>
+	/// @brief Returns a uniformly distributed integer in the range [0, t_bound).
+	/// </summary>
+	/// <param name="t_bound">Exclusive upper bound, must be greater than 0</param>
+	/// <returns>A random integer less than t_bound.</returns>
+	std::uint32_t below(std::uint32_t t_bound);
+
+	/// <summary>
+	/// @brief Returns a uniformly distributed integer in the range [t_min, t_max].
+	/// </summary>
+	int range(int t_min, int t_max);
+
+	// a float in the range [0, 1)
+	float unit();
+
+	// the internal state, so it can be saved and restored
+	std::uint32_t m_state[4];
+};
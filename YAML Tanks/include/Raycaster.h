@@ -0,0 +1,109 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "OrientedBoundingBox.h"
+#include "StaticColliders.h"
+#include "LevelLoader.h"
+
+// The kinds of object a ray can hit, combined into a mask to choose what a ray tests
+enum RaycastLayer : unsigned
+{
+	LAYER_WALL = 1 << 0,
+	LAYER_TARGET = 1 << 1,
+	LAYER_TANK = 1 << 2,
+	LAYER_ALL = LAYER_WALL | LAYER_TARGET | LAYER_TANK
+};
+
+/// <summary>
+/// @brief What a ray hit first.
+/// m_entity is the wall index, the target index or the tank slot, depending on the layer.
+/// </summary>
+struct RaycastHit
+{
+	RaycastLayer m_layer = LAYER_WALL;
+	int m_entity = -1;
+	sf::Vector2f m_point;
+
+	// unit vector out of the face that was hit, facing back along the ray if it started inside
+	sf::Vector2f m_normal;
+
+	float m_distance = 0.0f;
+};
+
+/// <summary>
+/// @brief Ray and line of sight queries against the walls, the active targets and the tanks.
+///
+/// Walls are found by walking the wall grid's cells along the ray, nearest first, so a
+///  ray stops looking as soon as it has hit something in the cells it has passed. There
+///  are only a few targets and tanks, so their boxes are tested directly.
+/// Queries do not change the raycaster, so several threads can cast rays at once.
+/// Example usage:
+///		Raycaster raycaster(walls, targetBoxes, targets);
+///		RaycastHit hit;
+///		if (raycaster.raycast(turretPos, aimDirection, 500.0f, LAYER_WALL | LAYER_TANK, hit)) ...
+///		bool seen = !raycaster.segmentBlocked(turretPos, playerPos);
+/// </summary>
+class Raycaster
+{
+public:
+	// the tank slots, the entity reported for a hit on the tank layer. AI tank i is slot AI_TANK + i
+	static constexpr int PLAYER_TANK = 0;
+	static constexpr int AI_TANK = 1;
+
+	/// <summary>
+	/// @brief Stores references to the level geometry, which must outlive the raycaster.
+	/// </summary>
+	/// <param name="t_walls">The baked wall boxes and their grid</param>
+	/// <param name="t_targetBoxes">The baked target boxes</param>
+	/// <param name="t_targets">Target data, only active targets that have not been shot can be hit</param>
+	Raycaster(StaticColliders const& t_walls, std::vector<OrientedBoundingBox> const& t_targetBoxes,
+		std::vector<TargetData> const& t_targets);
+
+	// updates the box of a tank, called each step before any rays are cast. Slots are added as they are first set
+	void setTankBox(int t_slot, OrientedBoundingBox const& t_box);
+
+	/// <summary>
+	/// @brief Finds the first object along a ray.
+	/// </summary>
+	/// <param name="t_origin">Where the ray starts</param>
+	/// <param name="t_direction">Direction of the ray, does not need to be normalised</param>
+	/// <param name="t_maxDistance">How far the ray reaches in pixels</param>
+	/// <param name="t_layerMask">The RaycastLayer values to test, combined with |</param>
+	/// <param name="t_hit">Set to the nearest hit, left alone if nothing was hit</param>
+	/// <returns>True if the ray hit something within t_maxDistance.</returns>
+	bool raycast(sf::Vector2f t_origin, sf::Vector2f t_direction, float t_maxDistance, unsigned t_layerMask, RaycastHit& t_hit) const;
+
+	/// <summary>
+	/// @brief Checks whether anything lies between two points, for line of sight checks.
+	/// </summary>
+	/// <param name="t_from">The looking point</param>
+	/// <param name="t_to">The point looked at</param>
+	/// <param name="t_layerMask">What can block the view, walls by default</param>
+	/// <returns>True if something on the given layers is in the way.</returns>
+	bool segmentBlocked(sf::Vector2f t_from, sf::Vector2f t_to, unsigned t_layerMask = LAYER_WALL) const;
+
+	/// <summary>
+	/// @brief Intersects a ray with one box (a slab test in the box's own frame).
+	/// </summary>
+	/// <param name="t_origin">Where the ray starts</param>
+	/// <param name="t_direction">Unit direction of the ray</param>
+	/// <param name="t_maxDistance">How far the ray reaches</param>
+	/// <param name="t_box">The box to test</param>
+	/// <param name="t_distance">Set to the distance to the hit, 0 if the ray starts inside</param>
+	/// <param name="t_normal">Set to the unit normal of the face hit</param>
+	/// <returns>True if the ray hits the box within t_maxDistance.</returns>
+	static bool intersect(sf::Vector2f t_origin, sf::Vector2f t_direction, float t_maxDistance,
+		OrientedBoundingBox const& t_box, float& t_distance, sf::Vector2f& t_normal);
+
+private:
+	// tests a box and keeps the hit if it is nearer than the current one
+	static void keepNearest(sf::Vector2f t_origin, sf::Vector2f t_direction, float t_maxDistance, OrientedBoundingBox const& t_box,
+		RaycastLayer t_layer, int t_entity, bool& t_found, RaycastHit& t_hit);
+
+	StaticColliders const& m_walls;
+	std::vector<OrientedBoundingBox> const& m_targetBoxes;
+	std::vector<TargetData> const& m_targets;
+
+	std::vector<OrientedBoundingBox> m_tankBoxes;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "InputSource.h"
+
+/// <summary>
+/// @brief Plays back player input saved by an InputRecorder.
+///
+/// The file holds one command per tick, one per line, as five numbers:
+///  throttle steer turret fire centreTurret (e.g. "1 0 -1 1 0").
+/// Once the recording runs out, no controls are held.
+/// </summary>
+class RecordedInput : public InputSource
+{
+public:
+	/// <summary>
+	/// @brief Reads the whole recording into memory.
+	/// An exception is thrown if the file can not be opened or a line is invalid.
+	/// </summary>
+	/// <param name="t_fileName">The recorded input file</param>
+	explicit RecordedInput(std::string const& t_fileName);
+
+	InputCommand nextInput(World const& t_world) override;
+
+	// true once every recorded command has been played
+	bool finished() const;
+
+	// number of ticks in the recording
+	std::size_t size() const;
+
+private:
+	std::vector<InputCommand> m_commands;
+
+	std::size_t m_next = 0;
+};
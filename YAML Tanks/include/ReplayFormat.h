@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "InputCommand.h"
+
+/// <summary>
+/// @brief Layout of a replay file, shared by ReplayRecorder and ReplayPlayer.
+///
+/// Header: magic "TKRP", version (u16), level (i32), seed (u64), step length in
+///  microseconds (u32) and keyframe interval in ticks (u32).
+/// Records follow, each starting with a type byte:
+///  'I' an input run: varint tick count, then one packed command used for all of them,
+///      so a held control costs two or three bytes however long it is held
+///  'K' a keyframe: varint tick, varint size, then a World::saveState() snapshot taken
+///      before that tick was stepped
+/// The index comes last: varint keyframe count, varint total ticks, then a varint tick
+///  and varint file offset per keyframe. The final 12 bytes are the index offset (u64)
+///  and the magic "TKIX", so a reader can find the index from the end of the file.
+/// </summary>
+namespace ReplayFormat
+{
+	static char const MAGIC[4] = { 'T', 'K', 'R', 'P' };
+	static char const INDEX_MAGIC[4] = { 'T', 'K', 'I', 'X' };
+	// raised whenever the simulation or the keyframe layout changes, older replays would not play back the same
+	static std::uint16_t const VERSION = 6;
+
+	static std::uint8_t const INPUT_RECORD = 'I';
+	static std::uint8_t const KEYFRAME_RECORD = 'K';
+
+	// size of the index offset and magic at the very end of the file
+	static std::size_t const TRAILER_SIZE = sizeof(std::uint64_t) + sizeof(INDEX_MAGIC);
+
+	/// <summary>
+	/// @brief Packs a command into one byte: two bits per axis (value + 1), then fire
+	///  and centre turret.
+	/// </summary>
+	inline std::uint8_t pack(InputCommand const& t_input)
+	{
+		return static_cast<std::uint8_t>((t_input.m_throttle + 1)
+			| ((t_input.m_steer + 1) << 2)
+			| ((t_input.m_turret + 1) << 4)
+			| (t_input.m_fire ? 0x40 : 0)
+			| (t_input.m_centreTurret ? 0x80 : 0));
+	}
+
+	inline InputCommand unpack(std::uint8_t t_packed)
+	{
+		InputCommand input;
+		input.m_throttle = static_cast<std::int8_t>((t_packed & 0x03) - 1);
+		input.m_steer = static_cast<std::int8_t>(((t_packed >> 2) & 0x03) - 1);
+		input.m_turret = static_cast<std::int8_t>(((t_packed >> 4) & 0x03) - 1);
+		input.m_fire = (t_packed & 0x40) != 0;
+		input.m_centreTurret = (t_packed & 0x80) != 0;
+		return input;
+	}
+}
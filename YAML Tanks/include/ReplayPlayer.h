@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "InputSource.h"
+#include "MappedFile.h"
+#include "ReplayFormat.h"
+#include "StateStream.h"
+
+/// <summary>
+/// @brief Plays back a replay file written by ReplayRecorder.
+///
+/// The file is memory mapped and its keyframe index read on construction. Create a
+///  World with level() and seed(), then either ask for inputs from the start or seek()
+///  to any tick first.
+/// Example usage:
+///		ReplayPlayer replay("match.tkr");
+///		World world(noTexture, noTexture, replay.level(), replay.seed());
+///		replay.seek(world, 3000);
+///		world.step(replay.msPerUpdate(), replay.nextInput(world));
+/// </summary>
+class ReplayPlayer : public InputSource
+{
+public:
+	/// <summary>
+	/// @brief Opens the replay and reads its header and index.
+	/// An exception is thrown if the file is missing, is not a replay or was not finished.
+	/// </summary>
+	/// <param name="t_fileName">The replay file</param>
+	explicit ReplayPlayer(std::string const& t_fileName);
+
+	/// <summary>
+	/// @brief Returns the recorded input for the next tick.
+	/// Once the recording runs out, no controls are held.
+	/// </summary>
+	InputCommand nextInput(World const& t_world) override;
+
+	/// <summary>
+	/// @brief Puts the world in its state at the start of the given tick.
+	/// Loads the nearest keyframe at or before the tick, then steps the world forward
+	///  with the recorded inputs. The world must use this replay's level and seed.
+	/// </summary>
+	/// <param name="t_world">The world to move</param>
+	/// <param name="t_tick">The tick to seek to, clamped to the length of the replay</param>
+	void seek(World& t_world, std::uint64_t t_tick);
+
+	int level() const;
+	std::uint64_t seed() const;
+	double msPerUpdate() const;
+
+	// number of recorded ticks
+	std::uint64_t tickCount() const;
+
+	// the tick the next input is for
+	std::uint64_t tick() const;
+
+	bool finished() const;
+
+private:
+	MappedFile m_file;
+
+	// reads the records, stops at the index
+	StateReader m_reader;
+
+	int m_level = 0;
+	std::uint64_t m_seed = 0;
+	double m_msPerUpdate = 0.0;
+	std::uint64_t m_tickCount = 0;
+
+	// file offset where the records end and the index starts
+	std::size_t m_indexOffset = 0;
+
+	// tick and file offset of each keyframe, in tick order
+	std::vector<std::uint64_t> m_indexTicks;
+	std::vector<std::size_t> m_indexOffsets;
+
+	std::uint64_t m_tick = 0;
+
+	// the input run being played
+	InputCommand m_runCommand;
+	std::uint64_t m_runRemaining = 0;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ReplayFormat.h"
+#include "StateStream.h"
+
+class World;
+
+/// <summary>
+/// @brief Records a match to a compact binary replay file (see ReplayFormat).
+///
+/// Call record() with the input for every tick, just before the world is stepped with it.
+///  Inputs are stored as run lengths of packed commands and a full world keyframe is
+///  written every few seconds, so a ReplayPlayer can seek without playing from the start.
+///  The index is written by finish(), or by the destructor if finish() was not called.
+/// Example usage:
+///		ReplayRecorder recorder("match.tkr", 1, seed, 10.0);
+///		recorder.record(world, input);
+///		world.step(10.0, input);
+/// </summary>
+class ReplayRecorder
+{
+public:
+	/// <summary>
+	/// @brief Creates the replay file and writes its header.
+	/// An exception is thrown if the file can not be created.
+	/// </summary>
+	/// <param name="t_fileName">The replay file to write</param>
+	/// <param name="t_levelNr">The level the world was created with</param>
+	/// <param name="t_seed">The seed the world was created with</param>
+	/// <param name="t_msPerUpdate">Step length in milliseconds</param>
+	/// <param name="t_keyframeSeconds">Simulated time between keyframes</param>
+	ReplayRecorder(std::string const& t_fileName, int t_levelNr, std::uint64_t t_seed,
+		double t_msPerUpdate, float t_keyframeSeconds = 5.0f);
+
+	~ReplayRecorder();
+
+	ReplayRecorder(ReplayRecorder const&) = delete;
+	ReplayRecorder& operator=(ReplayRecorder const&) = delete;
+
+	/// <summary>
+	/// @brief Adds one tick to the replay, with a keyframe first when one is due.
+	/// </summary>
+	/// <param name="t_world">The world as it is before this tick is stepped</param>
+	/// <param name="t_input">The input the world is about to be stepped with</param>
+	void record(World const& t_world, InputCommand const& t_input);
+
+	// writes the last input run and the keyframe index, nothing more can be recorded afterwards
+	void finish();
+
+private:
+	// writes the input run in progress, if any
+	void flushRun();
+
+	// writes the scratch buffer to the file and clears it
+	void writeScratch();
+
+	std::ofstream m_outputFile;
+
+	// bytes written to the file so far
+	std::uint64_t m_offset = 0;
+
+	// used to build each record before it is written
+	StateWriter m_scratch;
+
+	std::uint32_t m_keyframeTicks;
+
+	std::uint64_t m_tick = 0;
+
+	// the input run in progress
+	std::uint8_t m_runCommand = 0;
+	std::uint64_t m_runLength = 0;
+
+	// tick and file offset of each keyframe
+	std::vector<std::uint64_t> m_indexTicks;
+	std::vector<std::uint64_t> m_indexOffsets;
+
+	bool m_finished = false;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <SFML/System/Time.hpp>
+#include "StateStream.h"
+
+/// <summary>
+/// @brief The simulation clock.
+///
+/// Unlike sf::Clock it does not follow real time, it only moves forward when the
+///  simulation is stepped. Everything that is timed in the game is measured against it,
+///  so pausing, fast forwarding or running headless changes nothing in the results.
+/// </summary>
+class SimClock
+{
+public:
+	/// <summary>
+	/// @brief Moves the clock forward by one simulation step.
+	/// </summary>
+	/// <param name="dt">step length in milliseconds</param>
+	void advance(double dt);
+
+	/// <summary>
+	/// @brief Reads the total simulated time since the clock was created.
+	/// </summary>
+	/// <returns>The current simulation time.</returns>
+	sf::Time now() const;
+
+	// saves and restores the time, for replay keyframes
+	void saveState(StateWriter& t_writer) const;
+	void loadState(StateReader& t_reader);
+
+private:
+	// kept in whole microseconds so that repeated steps never drift
+	sf::Int64 m_microseconds = 0;
+};
+
+/// <summary>
+/// @brief A countdown timer driven by a SimClock.
+///
+/// Has the same interface as thor::Timer, which it replaces for all gameplay timers:
+///  reset() sets the time limit and stops the timer, start() runs it and it is
+///  expired once the limit has passed on the simulation clock.
+/// </summary>
+class SimTimer
+{
+public:
+	/// <summary>
+	/// @brief Creates a stopped, expired timer on the given clock.
+	/// </summary>
+	/// <param name="t_clock">The simulation clock that drives this timer</param>
+	explicit SimTimer(SimClock const& t_clock);
+
+	// sets the time limit and stops the timer
+	void reset(sf::Time t_timeLimit);
+
+	// sets the time limit and starts the timer
+	void restart(sf::Time t_timeLimit);
+
+	// starts or continues the timer, has no effect if it is already running
+	void start();
+
+	// pauses the timer, keeping the remaining time
+	void stop();
+
+	sf::Time getRemainingTime() const;
+
+	bool isRunning() const;
+
+	bool isExpired() const;
+
+	// saves and restores the timer, the clock it runs on is saved separately
+	void saveState(StateWriter& t_writer) const;
+	void loadState(StateReader& t_reader);
+
+private:
+	// time passed while running, not counting the current run
+	sf::Time elapsedTime() const;
+
+	SimClock const* m_clock;
+
+	sf::Time m_timeLimit;
+
+	// time accumulated by earlier runs
+	sf::Time m_elapsed;
+
+	// clock time when the current run started
+	sf::Time m_startTime;
+
+	bool m_running = false;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+/// <summary>
+/// @brief Things that happened during one simulation step.
+///
+/// The simulation has no audio of its own, so it counts the events here and
+///  Game plays the matching sounds after each step.
+/// </summary>
+struct SimEvents
+{
+	int m_playerShots = 0;
+	int m_wallHits = 0;
+	int m_targetsHit = 0;
+	int m_targetsAppeared = 0;
+
+	void clear()
+	{
+		m_playerShots = 0;
+		m_wallHits = 0;
+		m_targetsHit = 0;
+		m_targetsAppeared = 0;
+	}
+};
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/// <summary>
+/// @brief A uniform grid over static objects, used as the collision broad phase.
+///
+/// Built once from the wall sprites after they are generated. Each object is listed in
+///  every cell its bounding box overlaps, and a query only returns the objects listed in
+///  the cells its own box overlaps, so narrow phase SAT tests are only run against
+///  nearby walls instead of every wall in the level.
+/// The cells are stored as one flat index array with an offset per cell, and queries do
+///  not change the grid, so several threads can query it at once.
+/// Example usage:
+///		SpatialGrid grid;
+///		grid.build(wallSprites, 64.0f);
+///		std::vector<int> nearby;
+///		grid.query(tank.getGlobalBounds(), nearby);
+/// </summary>
+class SpatialGrid
+{
+public:
+	/// <summary>
+	/// @brief Builds the grid over the bounding boxes of the given sprites.
+	/// The grid covers the bounds of all of the sprites; queries outside it are clamped to
+	///  the edge cells.
+	/// </summary>
+	/// <param name="t_sprites">The static sprites, their indices are what queries return</param>
+	/// <param name="t_cellSize">Width and height of a cell in pixels</param>
+	void build(std::vector<sf::Sprite> const& t_sprites, float t_cellSize);
+
+	// the same for objects that are not sprites, given by their bounding boxes
+	void build(std::vector<sf::FloatRect> const& t_bounds, float t_cellSize);
+
+	/// <summary>
+	/// @brief Finds the objects whose bounding boxes overlap an area.
+	/// Each object is returned once, in no particular order.
+	/// </summary>
+	/// <param name="t_area">The area to search, usually a moving sprite's global bounds</param>
+	/// <param name="t_result">Cleared, then filled with the indices of the objects found</param>
+	void query(sf::FloatRect const& t_area, std::vector<int>& t_result) const;
+
+	/// <summary>
+	/// @brief Walks the cells a line segment passes through, nearest first (a DDA traversal).
+	/// For each cell the visitor is given the objects listed in it and the fraction of the
+	///  segment (0 to 1) at which the segment leaves the cell. An object spanning several cells
+	///  is given once per cell. The visitor returns true to stop, e.g. once it has a hit
+	///  nearer than the end of the cell, as nothing in a later cell can be nearer.
+	/// </summary>
+	/// <param name="t_start">Start of the segment</param>
+	/// <param name="t_end">End of the segment</param>
+	/// <param name="t_visit">Called as bool (int const* first, int const* last, float exitFraction)</param>
+	template <typename CellVisitor>
+	void traverse(sf::Vector2f t_start, sf::Vector2f t_end, CellVisitor&& t_visit) const;
+
+	// number of objects in the grid
+	int size() const;
+
+private:
+	// converts a world coordinate to a cell column or row, clamped to the grid
+	int cellColumn(float t_x) const;
+	int cellRow(float t_y) const;
+
+	float m_cellSize = 64.0f;
+	sf::Vector2f m_origin;
+	int m_columns = 0;
+	int m_rows = 0;
+
+	// bounding box of each object
+	std::vector<sf::FloatRect> m_bounds;
+
+	// m_cellObjects[m_cellStart[c] .. m_cellStart[c + 1]] are the objects in cell c
+	std::vector<int> m_cellStart;
+	std::vector<int> m_cellObjects;
+};
+
+////////////////////////////////////////////////////////////
+template <typename CellVisitor>
+void SpatialGrid::traverse(sf::Vector2f t_start, sf::Vector2f t_end, CellVisitor&& t_visit) const
+{
+	if (m_bounds.empty())
+	{
+		return;
+	}
+
+	float const infinity = std::numeric_limits<float>::infinity();
+	sf::Vector2f const delta = t_end - t_start;
+
+	// clip the segment to the grid, nothing outside it is listed in a cell
+	float enter = 0.0f;
+	float leave = 1.0f;
+	float const low[2] = { m_origin.x, m_origin.y };
+	float const high[2] = { m_origin.x + m_columns * m_cellSize, m_origin.y + m_rows * m_cellSize };
+	float const start[2] = { t_start.x, t_start.y };
+	float const direction[2] = { delta.x, delta.y };
+	for (int axis = 0; axis < 2; axis++)
+	{
+		if (direction[axis] == 0.0f)
+		{
+			if (start[axis] < low[axis] || start[axis] > high[axis])
+			{
+				return;
+			}
+			continue;
+		}
+		float first = (low[axis] - start[axis]) / direction[axis];
+		float last = (high[axis] - start[axis]) / direction[axis];
+		if (first > last)
+		{
+			std::swap(first, last);
+		}
+		enter = std::max(enter, first);
+		leave = std::min(leave, last);
+	}
+	if (enter > leave)
+	{
+		return;
+	}
+
+	int column = cellColumn(t_start.x + delta.x * enter);
+	int row = cellRow(t_start.y + delta.y * enter);
+	int const stepColumn = (delta.x > 0.0f) ? 1 : ((delta.x < 0.0f) ? -1 : 0);
+	int const stepRow = (delta.y > 0.0f) ? 1 : ((delta.y < 0.0f) ? -1 : 0);
+
+	// fraction of the segment at which it crosses the next column and row boundary, and how
+	// much further it goes to cross each one after that
+	float nextColumn = infinity;
+	float nextRow = infinity;
+	float columnDelta = infinity;
+	float rowDelta = infinity;
+	if (stepColumn != 0)
+	{
+		float boundary = m_origin.x + (column + (stepColumn > 0 ? 1 : 0)) * m_cellSize;
+		nextColumn = (boundary - t_start.x) / delta.x;
+		columnDelta = m_cellSize / std::abs(delta.x);
+	}
+	if (stepRow != 0)
+	{
+		float boundary = m_origin.y + (row + (stepRow > 0 ? 1 : 0)) * m_cellSize;
+		nextRow = (boundary - t_start.y) / delta.y;
+		rowDelta = m_cellSize / std::abs(delta.y);
+	}
+
+	while (true)
+	{
+		float const cellExit = std::min(std::min(nextColumn, nextRow), leave);
+		int const cell = row * m_columns + column;
+		int const* objects = m_cellObjects.data();
+		if (t_visit(objects + m_cellStart[cell], objects + m_cellStart[cell + 1], cellExit) || cellExit >= leave)
+		{
+			return;
+		}
+
+		if (nextColumn < nextRow)
+		{
+			column += stepColumn;
+			nextColumn += columnDelta;
+		}
+		else
+		{
+			row += stepRow;
+			nextRow += rowDelta;
+		}
+
+		if (column < 0 || column >= m_columns || row < 0 || row >= m_rows)
+		{
+			return;
+		}
+	}
+}
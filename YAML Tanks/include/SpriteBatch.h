@@ -0,0 +1,89 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// The order sprites are drawn in, later layers on top
+enum class DrawLayer
+{
+	TARGETS,
+	TANKS,
+	PICKUPS,
+	BULLETS
+};
+
+/// <summary>
+/// @brief Collects the sprites drawn in a frame and draws them with as few draw calls as possible.
+///
+/// Sprites are submitted with a layer, then flush() sorts them by layer and texture and draws
+///  each run of sprites sharing a texture as one vertex array. Layers are drawn in increasing
+///  order, so a higher layer is always on top; within a layer sprites are grouped by texture,
+///  so sprites on the same layer should not overlap unless their texture is shared. Runs of
+///  the same texture carry on across layers, so with every image in one atlas page the whole
+///  frame is a single draw call.
+/// Example usage:
+///		batch.begin();
+///		batch.draw(tankSprite, DrawLayer::TANKS);
+///		batch.draw(bulletSprite, DrawLayer::BULLETS);
+///		batch.flush(window);
+///		int calls = batch.stats().m_drawCalls;
+/// </summary>
+class SpriteBatch
+{
+public:
+	// what the last flush() drew
+	struct Stats
+	{
+		int m_sprites = 0;
+		int m_drawCalls = 0;
+		int m_vertices = 0;
+
+		// draw calls that changed the texture, untextured sprites need no texture
+		int m_textureBinds = 0;
+	};
+
+	// forgets the sprites submitted since the last flush, called at the start of every frame
+	void begin();
+
+	/// <summary>
+	/// @brief Adds a sprite to be drawn by the next flush(), as it is now.
+	/// </summary>
+	/// <param name="t_sprite">The sprite, its transform, texture rect and colour are copied</param>
+	/// <param name="t_layer">Sprites on higher layers are drawn on top</param>
+	void draw(sf::Sprite const& t_sprite, DrawLayer t_layer);
+
+	/// <summary>
+	/// @brief Draws every sprite submitted since begin(), sorted by layer and texture, and
+	///  records the counts in stats().
+	/// </summary>
+	/// <param name="t_target">Where the sprites are drawn</param>
+	void flush(sf::RenderTarget& t_target);
+
+	Stats const& stats() const;
+
+	// 2 triangles per sprite
+	static constexpr std::size_t VERTICES_PER_SPRITE = 6;
+
+	// writes the VERTICES_PER_SPRITE vertices that draw a sprite as sf::Triangles
+	static void spriteVertices(sf::Sprite const& t_sprite, sf::Vertex* t_vertices);
+
+private:
+	struct Item
+	{
+		DrawLayer m_layer;
+		sf::Texture const* m_texture;
+
+		// the item's first vertex in m_vertices
+		std::size_t m_first;
+	};
+
+	std::vector<Item> m_items;
+
+	// the submitted sprites' vertices in the order they were submitted
+	std::vector<sf::Vertex> m_vertices;
+
+	// the vertices in drawing order, each run of a texture is drawn straight from here
+	std::vector<sf::Vertex> m_sorted;
+
+	Stats m_stats;
+};
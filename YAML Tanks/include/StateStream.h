@@ -0,0 +1,105 @@
+#pragma once
+
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// <summary>
+/// @brief Appends binary data to a growing byte buffer.
+///
+/// Used to take snapshots of the world for replay keyframes and to build the replay
+///  file itself. Values are stored in the byte order of the machine; replays are
+///  only read back on the same platform that wrote them.
+/// </summary>
+class StateWriter
+{
+public:
+	/// <summary>
+	/// @brief Writes any plain number or enum as its raw bytes.
+	/// </summary>
+	template <typename T>
+	void write(T t_value)
+	{
+		static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "only plain values can be written");
+		std::size_t const size = m_buffer.size();
+		m_buffer.resize(size + sizeof(T));
+		std::memcpy(m_buffer.data() + size, &t_value, sizeof(T));
+	}
+
+	/// <summary>
+	/// @brief Writes an unsigned number in 7 bit groups, low group first, so small numbers
+	///  take a single byte.
+	/// </summary>
+	void writeVarint(std::uint64_t t_value);
+
+	void writeBytes(void const* t_data, std::size_t t_size);
+	void writeString(std::string const& t_value);
+	void writeVector(sf::Vector2f t_value);
+	void writeTime(sf::Time t_value);
+
+	// only the position and rotation, the rest of a sprite never changes during a match
+	void writeSprite(sf::Sprite const& t_sprite);
+
+	std::vector<std::uint8_t> const& buffer() const;
+
+	void clear();
+
+private:
+	std::vector<std::uint8_t> m_buffer;
+};
+
+/// <summary>
+/// @brief Reads back data written by a StateWriter.
+///
+/// Reads from memory it does not own, e.g. a memory mapped replay file.
+/// An exception is thrown if a read runs past the end of the data.
+/// </summary>
+class StateReader
+{
+public:
+	StateReader(std::uint8_t const* t_data, std::size_t t_size);
+
+	template <typename T>
+	T read()
+	{
+		static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "only plain values can be read");
+		T value;
+		std::memcpy(&value, take(sizeof(T)), sizeof(T));
+		return value;
+	}
+
+	// reads a value into an existing variable, so the type does not have to be repeated
+	template <typename T>
+	void read(T& t_value)
+	{
+		t_value = read<T>();
+	}
+
+	std::uint64_t readVarint();
+	void readBytes(void* t_data, std::size_t t_size);
+	std::string readString();
+	sf::Vector2f readVector();
+	sf::Time readTime();
+	void readSprite(sf::Sprite& t_sprite);
+
+	// bytes read so far
+	std::size_t position() const;
+
+	// moves to an absolute position in the data
+	void seek(std::size_t t_position);
+
+	bool atEnd() const;
+
+private:
+	// returns the next t_size bytes and moves past them
+	std::uint8_t const* take(std::size_t t_size);
+
+	std::uint8_t const* m_data;
+	std::size_t m_size;
+	std::size_t m_position = 0;
+};
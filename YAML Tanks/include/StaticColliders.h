@@ -0,0 +1,55 @@
+#pragma once
+
+#include <SFML/Graphics/Sprite.hpp>
+#include <vector>
+#include "OrientedBoundingBox.h"
+#include "SpatialGrid.h"
+#include "BoxBatch.h"
+
+/// <summary>
+/// @brief The collision data for objects that never move, baked once when the level is built.
+///
+/// Holds one OrientedBoundingBox per sprite (corners, edge axes and projection intervals,
+///  64 bytes each, stored contiguously) and the SpatialGrid broad phase over them. After
+///  build() the sprites are no longer needed for collision checks.
+/// Example usage:
+///		StaticColliders walls;
+///		walls.build(wallSprites, 64.0f);
+///		walls.query(bounds, nearby);
+///		walls.gather(nearby, batch);
+///		CollisionDetector::collidesWithAny(tankBox, batch);
+/// </summary>
+class StaticColliders
+{
+public:
+	/// <summary>
+	/// @brief Bakes the boxes and builds the grid.
+	/// </summary>
+	/// <param name="t_sprites">The static sprites, box i belongs to sprite i</param>
+	/// <param name="t_cellSize">Grid cell size in pixels</param>
+	void build(std::vector<sf::Sprite> const& t_sprites, float t_cellSize);
+
+	// finds the colliders whose bounding boxes overlap an area, see SpatialGrid::query()
+	void query(sf::FloatRect const& t_area, std::vector<int>& t_result) const;
+
+	OrientedBoundingBox const& box(int t_index) const;
+
+	// the broad phase grid, for walking the cells along a ray
+	SpatialGrid const& grid() const;
+
+	/// <summary>
+	/// @brief Copies the boxes found by query() into a batch for CollisionDetector::collisionMask().
+	/// </summary>
+	/// <param name="t_indices">Collider indices, as returned by query()</param>
+	/// <param name="t_batch">Cleared, then filled with the boxes in the same order</param>
+	void gather(std::vector<int> const& t_indices, BoxBatch& t_batch) const;
+
+	std::vector<OrientedBoundingBox> const& boxes() const;
+
+	int size() const;
+
+private:
+	std::vector<OrientedBoundingBox> m_boxes;
+
+	SpatialGrid m_grid;
+};
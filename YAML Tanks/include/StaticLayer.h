@@ -0,0 +1,59 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/// <summary>
+/// @brief A cache of everything in the world that never moves (the background and the walls).
+///
+/// The layer is drawn once into render textures, split into tiles of TILE_SIZE pixels so a
+///  large world does not need one huge texture, and each frame only the tiles are drawn.
+///  It is drawn again on the next frame after invalidate(), which is only needed when the
+///  level geometry changes. If the render textures can not be created, the contents are
+///  drawn directly every frame instead.
+/// Example usage:
+///		staticLayer.create(sf::Vector2u(ScreenSize::s_width, ScreenSize::s_height));
+///		staticLayer.render(window, [&](sf::RenderTarget& t_target) { t_target.draw(background); world.renderStatic(t_target); });
+/// </summary>
+class StaticLayer
+{
+public:
+	// width and height of a tile in pixels
+	static constexpr unsigned TILE_SIZE = 512;
+
+	/// <summary>
+	/// @brief Creates the tiles covering the world, from (0,0) to the given size.
+	/// </summary>
+	/// <param name="t_worldSize">Size of the world in pixels</param>
+	void create(sf::Vector2u t_worldSize);
+
+	// marks the cached layer as out of date, it is drawn again on the next render()
+	void invalidate();
+
+	/// <summary>
+	/// @brief Draws the layer, first drawing its contents into the tiles if they are out of date.
+	/// </summary>
+	/// <param name="t_target">Where the layer is drawn, in world coordinates</param>
+	/// <param name="t_drawContents">Draws everything in the layer to the target it is given</param>
+	void render(sf::RenderTarget& t_target, std::function<void(sf::RenderTarget&)> const& t_drawContents);
+
+private:
+	// draws the contents into every tile
+	void rebuild(std::function<void(sf::RenderTarget&)> const& t_drawContents);
+
+	struct Tile
+	{
+		sf::FloatRect m_area;
+		std::unique_ptr<sf::RenderTexture> m_texture;
+		sf::Sprite m_sprite;
+	};
+
+	std::vector<Tile> m_tiles;
+
+	bool m_dirty = true;
+
+	// set if a render texture could not be created, the contents are then drawn directly
+	bool m_uncached = false;
+};
@@ -1,9 +1,10 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <SFML/Audio.hpp>
 #include "CollisionDetector.h"
 #include "Bullet.h"
-#include "Thor/Time.hpp"
+#include "InputCommand.h"
+#include "SimEvents.h"
+#include "SimClock.h"
 
 /// <summary>
 /// @brief A simple tank controller.
@@ -19,12 +20,36 @@ public:
 /// Creates sprites for the tank base and turret from the supplied texture.
 /// </summary>
 /// <param name="t_texture">A reference to the sprite sheet texture</param>
-///< param name="t_wallSprites">A reference to the container of wall sprites</param>  
-	Tank(sf::Texture const& texture, std::vector<sf::Sprite>& t_wallSprites,
-		std::vector<sf::Sprite>& t_targetSprites, std::vector<TargetData>& t_targets);
+/// <param name="t_walls">The baked wall colliders</param>
+/// <param name="t_targetBoxes">The baked target boxes, one per target</param>
+/// <param name="t_targets">The level's target data</param>
+/// <param name="t_clock">The simulation clock that drives the firing cooldown</param>
+	Tank(sf::Texture const& texture, StaticColliders const& t_walls,
+		std::vector<OrientedBoundingBox> const& t_targetBoxes, std::vector<TargetData>& t_targets, SimClock const& t_clock);
+
+	/// <summary>
+	/// @brief Advances the tank by one simulation step.
+	/// Applies the supplied input, moves the tank and its bullets and records
+	///  any shots fired or bullet wall hits in the supplied events.
+	/// </summary>
+	/// <param name="dt">update delta time in milliseconds</param>
+	/// <param name="t_input">The player input for this step</param>
+	/// <param name="t_events">Collects the events raised during this step</param>
+	void update(double dt, InputCommand const& t_input, SimEvents& t_events);
+	/// <summary>
+	/// @brief Draws the tank base and turret blended between the previous and current step.
+	/// </summary>
+	/// <param name="t_batch">The batch the sprites are added to</param>
+	/// <param name="alpha">How far the frame is between the previous and current step (0 to 1)</param>
+	void render(SpriteBatch& t_batch, float alpha);
+
+	// remembers the current sprite transforms as the previous step's, called before each step
+	void storePreviousState();
+
+	// saves and restores everything that changes during a match, for replay keyframes
+	void saveState(StateWriter& t_writer) const;
+	void loadState(StateReader& t_reader);
 
-	void update(double dt);
-	void render(sf::RenderWindow& window);
 	void setPosition(sf::Vector2f& position);
 	/// <summary>
 /// @brief Increases the speed by 1, max speed is capped at 100.
@@ -51,7 +76,7 @@ public:
 	void decreaseRotation();
 
 	// checks for player input and calls appropriate function, such as pressing up key to increase speed
-	void handleKeyInput();
+	void handleKeyInput(InputCommand const& t_input);
 
 	//indepently rotate the turret without affecting the tank base
 	void increaseTurretRotation();
@@ -89,6 +114,13 @@ public:
 	sf::Sprite getBase() const;
 	sf::Sprite getTurret() const;
 
+	// collision boxes of the base and turret, rebuilt only when the tank has moved
+	OrientedBoundingBox const& getBaseBox() const;
+	OrientedBoundingBox const& getTurretBox() const;
+
+	// true while the tank is not moving, used by Game to control the moving sound
+	bool isStopped() const;
+
 	// fuel in the player tank
 	double m_fuel = 3000.0f;
 
@@ -99,31 +131,31 @@ public:
 	float m_bulletsFiredHighScore = 0;
 
 private:
+	// rebuilds the base and turret boxes if their sprites have moved or turned since the last build
+	void updateBoxes();
+
 	void initSprites();
-	void initSounds();
 	void adjustRotation();
 	void gradualStop();
-	void processBullets(double dt);
+	void processBullets(double dt, InputCommand const& t_input, SimEvents& t_events);
 
 	sf::Sprite m_tankBase;
 	sf::Sprite m_turret;
 	sf::Texture const& m_texture;
 
-	sf::SoundBuffer m_tankFiringBuffer;
-	sf::Sound m_tankFiringSound;
-
-	sf::SoundBuffer m_tankMovingBuffer;
-	sf::Sound m_tankMovingSound;
-	bool m_toggleMovingSound = false;
 	bool m_stopped = true;
 
-	void soundControl();
+	// the baked wall boxes and their grid, so collision checks only test nearby walls
+	StaticColliders const& m_walls;
 
-	// A reference to the container of wall sprites.
-	std::vector<sf::Sprite>& m_wallSprites;
+	// walls near the tank, reused by every wall collision check
+	std::vector<int> m_nearbyWalls;
 
-	// reference to container of target sprites
-	std::vector<sf::Sprite>& m_targetSprites;
+	// the boxes of those walls laid out for the batch collision test
+	BoxBatch m_nearbyBoxes;
+
+	// reference to the baked target boxes
+	std::vector<OrientedBoundingBox> const& m_targetBoxes;
 
 	std::vector<TargetData>& m_targets; 
 
@@ -133,7 +165,7 @@ private:
 
 	// previous position and speed of tank used in collison processing
 	sf::Vector2f m_previousPosition;
-	double m_previousSpeed;
+	double m_previousSpeed{ 0.0 };
 
 	// The current rotation as applied to tank base and turret.
 	double m_baseRotation{ 0.0 };
@@ -146,11 +178,26 @@ private:
 	// store previous turret pos to control toggling turret rotating sound 
 	sf::Vector2f m_previousTurretPosition;
 
+	// sprite transforms at the start of the current step, used to interpolate rendering
+	sf::Vector2f m_renderBasePosition;
+	sf::Vector2f m_renderTurretPosition;
+	float m_renderBaseRotation{ 0.0f };
+	float m_renderTurretRotation{ 0.0f };
+
 	// control when rotation can be done
 	bool m_enableRotation = true;
 
+	// collision boxes for the base and turret and the transforms they were built from
+	OrientedBoundingBox m_baseBox;
+	OrientedBoundingBox m_turretBox;
+	sf::Vector2f m_baseBoxPosition;
+	sf::Vector2f m_turretBoxPosition;
+	float m_baseBoxRotation{ 0.0f };
+	float m_turretBoxRotation{ 0.0f };
+	bool m_boxesDirty = true;
+
 	// timer that controls the rate of fire of the tank
-	thor::Timer m_firingTimer;
+	SimTimer m_firingTimer;
 	static constexpr float FIRING_COOLDOWN = 1.0f;
 	
 };
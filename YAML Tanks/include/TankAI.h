@@ -3,139 +3,391 @@
 #include "Tank.h"
 #include "CollisionDetector.h"
 #include "ScreenSize.h"
+#include "Random.h"
+#include "LineOfSight.h"
+#include "PathQueue.h"
+#include "FlowField.h"
+#include "ThreadPool.h"
+#include "SpatialGrid.h"
 #include <SFML/Graphics.hpp>
 #include <Thor/Vectors.hpp>
 #include <Thor/Shapes.hpp>
 #include <iostream>
 #include <queue>
+#include <limits>
+#include <memory>
 
+/// <summary>
+/// @brief All of the AI controlled tanks in a level.
+///
+/// Each piece of AI state is kept in its own array with one entry per tank (positions in one,
+///  velocities in another and so on), and update() runs over every tank in one pass:
+///  - scheduling, which picks the tanks that look and decide this step
+///  - route planning, which uses the random generator and the path queue, in tank order
+///  - steering and movement, which only read the level and the tank's own state and only
+///    write the tank's own entries, so it is split into chunks run on a thread pool
+///  - one batched vision cone check, behaviour changes and bullets, in tank order
+/// Tanks chasing the player or near it look and decide every step. Distant patrolling tanks
+///  only do so every DECISION_INTERVAL steps, spread out so they do not all decide on the same
+///  step, and in between keep driving with the velocity they last chose. At most the decision
+///  budget of them decide in one step, the rest wait for the next, stalest first.
+/// Every tank is steered by the same arithmetic whichever thread runs it, so replays play
+///  back the same with or without a pool. A tank's index is the order it was declared in
+///  the level file.
+/// Example usage:
+///		aiTanks.init(level.m_aiTanks);
+///		aiTanks.setThreadPool(&pool);
+///		aiTanks.update(playerTank, dt, events);
+///		for (int i = 0; i < aiTanks.count(); i++) raycaster.setTankBox(Raycaster::AI_TANK + i, aiTanks.getBaseBox(i));
+/// </summary>
 class TankAi
 {
 public:
+	// counts since the tanks were created
+	struct Stats
+	{
+		// tank steps with full perception and decisions, near the player or chasing it
+		int m_fullUpdates = 0;
+
+		// distant tanks that took their turn to look and decide
+		int m_reducedUpdates = 0;
+
+		// tank steps where the tank only kept moving
+		int m_extrapolated = 0;
+
+		// distant tanks whose turn was put off to a later step by the budget
+		int m_deferred = 0;
+	};
+
+	// how often a distant patrolling tank looks and decides, in steps
+	static constexpr int DECISION_INTERVAL = 10;
+
+	// the default for setDecisionBudget()
+	static constexpr int DEFAULT_DECISION_BUDGET = 32;
+
 	/// <summary>
-	/// @brief Constructor that stores a reference to the obstacle container.
-	/// Initialises steering behaviour to seek (player) mode, sets the AI tank position and
-	///  initialises the steering vector to (0,0) meaning zero force magnitude.
+	/// @brief Constructor that stores references to the level the tanks drive around.
+	/// No tanks exist until init() is called.
 	/// </summary>
 	/// <param name="texture">A reference to the sprite sheet texture</param>
 	///< param name="wallSprites">A reference to the container of wall sprites</param>
-	TankAi(sf::Texture const& texture, std::vector<sf::Sprite>& wallSprites);
+	/// <param name="walls">The baked wall colliders, used by the bullet wall checks</param>
+	/// <param name="lineOfSight">Vision cone checks, the player can not be spotted through walls</param>
+	/// <param name="navGrid">The walkable cells the tanks plan their paths over</param>
+	/// <param name="paths">The queue the tanks' patrol path requests are searched by</param>
+	/// <param name="flowField">Directions towards the player, shared by every chasing tank</param>
+	/// <param name="clock">The simulation clock that drives the AI timers</param>
+	/// <param name="random">The world's random number generator, used to pick patrol destinations</param>
+	TankAi(sf::Texture const& texture, std::vector<sf::Sprite>& wallSprites, StaticColliders const& walls,
+		LineOfSight& lineOfSight, NavGrid const& navGrid, PathQueue& paths, FlowField& flowField, SimClock const& clock, Random& random);
+
+	/// <summary>
+	/// @brief Sets the pool that steers the tanks in parallel.
+	/// Without one, or with too few tanks to be worth splitting, they are steered on the
+	///  calling thread. The pool must not be shared with work that outlives a step, as
+	///  update() waits for the pool to go idle.
+	/// </summary>
+	/// <param name="t_pool">The pool to use, or nullptr</param>
+	void setThreadPool(ThreadPool* t_pool);
 
-	void update(Tank & playerTank, double dt);
+	/// <summary>
+	/// @brief Sets how many distant tanks may look and decide in one step.
+	/// Tanks near the player or chasing it are never held back and do not count. The budget
+	///  is a number of tanks rather than a time, so that a replay plays back the same on any
+	///  machine.
+	/// </summary>
+	/// <param name="t_decisions">The most distant tanks that decide in one step, at least 1</param>
+	void setDecisionBudget(int t_decisions);
+
+	/// <summary>
+	/// @brief Advances every AI tank by one simulation step.
+	/// Bullet wall hits are recorded in the supplied events.
+	/// </summary>
+	/// <param name="playerTank">The player tank instance</param>
+	/// <param name="dt">update delta time in milliseconds</param>
+	/// <param name="t_events">Collects the events raised during this step</param>
+	void update(Tank & playerTank, double dt, SimEvents& t_events);
 
 	/// <summary>
-	/// @brief Draws the tank base and turret.
+	/// @brief Draws each tank's base and turret blended between the previous and current step.
 	///
 	/// </summary>
-	/// <param name="window">The SFML Render window</param>
-	void render(sf::RenderWindow& window);
+	/// <param name="t_batch">The batch the sprites are added to</param>
+	/// <param name="alpha">How far the frame is between the previous and current step (0 to 1)</param>
+	void render(SpriteBatch& t_batch, float alpha);
+
+	/// <summary>
+	/// @brief Draws each tank's vision cone, and the obstacle circles when they are shown, over
+	///  the sprites once the batch has been drawn.
+	/// </summary>
+	/// <param name="t_target">Where the shapes are drawn</param>
+	/// <param name="alpha">How far the frame is between the previous and current step (0 to 1)</param>
+	void renderOverlay(sf::RenderTarget& t_target, float alpha);
+
+	// remembers the current tank transforms as the previous step's, called before each step
+	void storePreviousState();
+
+	// saves and restores everything that changes during a match, for replay keyframes
+	void saveState(StateWriter& t_writer) const;
+	void loadState(StateReader& t_reader);
 
 	/// <summary>
-	/// @brief Initialises the obstacle container and sets the tank base/turret sprites to the specified position.
-	/// <param name="position">An x,y position</param>
+	/// @brief Creates one tank for each entry, initialises the obstacle container and sets up the vision cones.
+	/// <param name="tanks">The AI tanks declared by the level</param>
 	/// </summary>
-	void init(sf::Vector2f position);
+	void init(std::vector<TankData> const& tanks);
 
 	/// <summary>
-/// @brief Checks for collision between the AI and player tanks.
+/// @brief Checks for collision between any AI tank and the player tank.
 ///
 /// </summary>
 /// <param name="player">The player tank instance</param>
-/// <returns>True if collision detected between AI and player tanks.</returns>
+/// <returns>True if collision detected between an AI tank and the player tank.</returns>
 	bool collidesWithPlayer(Tank const& playerTank) const;
 
-	Bullet m_AIBullets[NUM_AI_BULLETS];
+	// the number of AI tanks
+	int count() const;
+
+	Stats const& stats() const;
+
+	// the collision box of a tank's base where it is now
+	OrientedBoundingBox const& getBaseBox(int tank) const;
+
+	/// <summary>
+	/// @brief Turns drawing of the circles the tanks steer around on or off, for debugging.
+	/// The circles are only built the first time drawing is turned on.
+	/// </summary>
+	/// <param name="t_show">True to draw the circles</param>
+	void showObstacles(bool t_show);
+
+	// NUM_AI_BULLETS for each tank, tank i owns the bullets from i * NUM_AI_BULLETS
+	std::vector<Bullet> m_AIBullets;
 
 private:
+	enum class AiBehaviour
+	{
+		ATTACK_PLAYER,
+		PATROL
+	};
+
+	// a circle round a wall that the tanks steer around
+	struct ObstacleCircle
+	{
+		sf::Vector2f m_center;
+		float m_radiusSq;
+	};
+
 	void initSprites();
 
-	void setVisionCone();
+	// a copy of one of the shared sprites, moved to a tank's position and rotation
+	static sf::Sprite placeSprite(sf::Sprite const& sprite, sf::Vector2f position, float rotation);
+
+	// decides which tanks look and decide this step
+	void scheduleDecisions(sf::Vector2f playerPosition);
+
+	// picks patrol destinations and requests paths, the parts of steering that change shared state
+	void planRoutes();
 
-	void updateMovement(double dt);
+	// steers and moves the tanks from first up to last
+	void steer(int first, int last, sf::Vector2f playerPosition, double dt);
 
-	void updateVisionCone(Tank const& playerTank);
+	// the steering force for a tank this step, from its behaviour and the obstacles ahead
+	void updateSteering(int tank, sf::Vector2f playerPosition);
 
-	void processBullets(double dt, Tank& playerTank);
+	// turns a tank towards its velocity and moves it
+	void updateMovement(int tank, double dt);
 
-	bool isLeft(sf::Vector2f t_linePoint1,
-		sf::Vector2f t_linePoint2,
-		sf::Vector2f t_point) const;
+	// rebuilds a tank's collision boxes if it has moved or turned since they were built, or
+	// always if force is set
+	void updateBoxes(int tank, bool force);
 
-	sf::Vector2f chase(sf::Vector2f playerPosition) const;
-	sf::Vector2f patrol();
+	// builds each tank's vision cone, checks them all at once and switches behaviours
+	void updateVisionCones(Tank const& playerTank);
 
-	float distanceBetween(sf::Vector2f playerPos, sf::Vector2f aiPos);
+	void processBullets(int tank, double dt, Tank& playerTank, SimEvents& t_events);
 
-	sf::Vector2f collisionAvoidance();
+	// a vision cone from a tank's turret, pointing along the given angle in degrees
+	SightQuery visionCone(int tank, float t_angle, float t_length, float t_halfAngle) const;
 
-	const sf::CircleShape findMostThreateningObstacle();
+	// heads straight for the player when no wall is in the way, otherwise follows the flow field
+	sf::Vector2f chase(int tank, sf::Vector2f playerPosition);
+
+	// picks a new patrol destination when the tank needs one
+	void patrol(int tank);
+
+	/// <summary>
+	/// @brief Takes a tank's new path if one has arrived, and asks for another when its goal has
+	///  moved into a different navigation cell.
+	/// The tank keeps to its current path until the new one arrives a step or two later.
+	/// </summary>
+	/// <param name="tank">The tank planning its path</param>
+	/// <param name="goal">Where the tank is heading</param>
+	void requestPath(int tank, sf::Vector2f goal);
+
+	/// <summary>
+	/// @brief Steers a tank along its planned path towards a goal.
+	/// </summary>
+	/// <param name="tank">The tank to steer</param>
+	/// <param name="goal">Where the tank is heading</param>
+	/// <returns>A vector from the tank to the next waypoint, or to the goal itself on the last stretch.</returns>
+	sf::Vector2f followPath(int tank, sf::Vector2f goal);
+
+	float distanceBetween(sf::Vector2f playerPos, sf::Vector2f aiPos) const;
+
+	sf::Vector2f collisionAvoidance(int tank) const;
+
+	/// <summary>
+	/// @brief Finds the nearest obstacle that the ahead or half-ahead point is inside.
+	/// Only the obstacles listed in the grid cells between the two points are tested.
+	/// </summary>
+	/// <param name="position">The tank's position</param>
+	/// <param name="ahead">The point the tank looks ahead to</param>
+	/// <param name="halfAhead">The point half way there</param>
+	/// <returns>The index of the obstacle in m_obstacles, or -1 if there is none in the way.</returns>
+	int findMostThreateningObstacle(sf::Vector2f position, sf::Vector2f ahead, sf::Vector2f halfAhead) const;
 
 	// A reference to the sprite sheet texture.
 	sf::Texture const & m_texture;
 
-	// A sprite for the tank base.
+	// Sprites for the tank base and turret, moved to each tank in turn when drawing.
 	sf::Sprite m_tankBase;
-
-	// A sprite for the turret
 	sf::Sprite m_turret;
 
+	// Vision cone visualisation, shared by every tank in the same way.
+	thor::Arrow m_arrowLeft;
+	thor::Arrow m_arrowRight;
+
 	// A reference to the container of wall sprites.
 	std::vector<sf::Sprite> & m_wallSprites;
 
-	// The current rotation as applied to tank base and turret.
-	float m_rotation{ 0.0 };
+	// the baked wall colliders, used by the bullet wall checks
+	StaticColliders const & m_walls;
+
+	// vision cone checks against the level, shared with the world's other observers
+	LineOfSight & m_lineOfSight;
+
+	// the walkable cells paths are planned over
+	NavGrid const & m_navGrid;
+
+	// the way to the player from anywhere in the level
+	FlowField & m_flowField;
+
+	// searches the tanks' paths
+	PathQueue & m_paths;
+
+	// A reference to the world's random number generator.
+	Random & m_random;
+
+	// the clock the tanks' timers are created on
+	SimClock const & m_clock;
+
+	// steers the tanks in parallel, not owned
+	ThreadPool* m_pool = nullptr;
+
+	// Per tank state, one entry per tank.
+	// Flags are bytes rather than std::vector<bool>, so each tank's entry is a separate object.
+
+	// The position of the tank base and turret.
+	std::vector<sf::Vector2f> m_position;
+
+	// The current rotation of the tank base, and of the turret.
+	std::vector<float> m_rotation;
+	std::vector<float> m_turretRotation;
 
 	// Current velocity.
-	sf::Vector2f m_velocity;
+	std::vector<sf::Vector2f> m_velocity;
 
 	// Steering vector.
-	sf::Vector2f m_steering;
+	std::vector<sf::Vector2f> m_steering;
 
-	// The ahead vector.
-	sf::Vector2f m_ahead;
-
-	// The half-ahead vector.
-	sf::Vector2f m_halfAhead;
+	std::vector<AiBehaviour> m_behaviour;
 
 	// point tank will make its way to when not chasing player
-	sf::Vector2f m_destination;
+	std::vector<sf::Vector2f> m_destination;
+	std::vector<std::uint8_t> m_patrolDestinationGenerated;
 
-	// The maximum see ahead range.
-	static float constexpr MAX_SEE_AHEAD{ 50.0f };
+	// the angle the vision cone has swept round to while patrolling
+	std::vector<float> m_visionConeSweepAngle;
 
-	// The maximum avoidance turn rate.
-	static float constexpr MAX_AVOID_FORCE{ 50.0f };
+	// the edges of the vision cone as last drawn, from the turret
+	std::vector<sf::Vector2f> m_visionConeLeft;
+	std::vector<sf::Vector2f> m_visionConeRight;
 
-	static float constexpr MAX_FORCE{ 10.0f };
+	// the ticket each tank's path requests are made with, its current path, the waypoint being
+	// driven to and the cell of the goal last requested
+	std::vector<int> m_pathRequester;
+	std::vector<std::vector<sf::Vector2f>> m_path;
+	std::vector<int> m_pathIndex;
+	std::vector<int> m_pathGoalCell;
 
-	static float constexpr MASS{ 10.0f };
+	// timers that control the rate of fire, and the delay before giving up a chase
+	std::vector<SimTimer> m_firingTimer;
+	std::vector<SimTimer> m_backToPatrolDelay;
 
-	// The maximum speed for this tank.
-	float MAX_SPEED = 50.0f;
+	// collision boxes for each tank's base and turret and the transforms they were built from
+	std::vector<OrientedBoundingBox> m_baseBox;
+	std::vector<OrientedBoundingBox> m_turretBox;
+	std::vector<sf::Vector2f> m_boxPosition;
+	std::vector<float> m_baseBoxRotation;
+	std::vector<float> m_turretBoxRotation;
 
-	// A container of circles that represent the obstacles to avoid.
-	std::vector<sf::CircleShape> m_obstacles;
+	// tank transforms at the start of the current step, used to interpolate rendering
+	std::vector<sf::Vector2f> m_renderPosition;
+	std::vector<float> m_renderBaseRotation;
+	std::vector<float> m_renderTurretRotation;
 
-	enum class AiBehaviour
-	{
-		ATTACK_PLAYER,
-		PATROL 
-	} m_aiBehaviour;
+	// the step each tank last looked and decided on, and whether it does so this step
+	std::vector<int> m_lastDecision;
+	std::vector<std::uint8_t> m_deciding;
+
+	// steps taken so far
+	int m_step = 0;
+
+	int m_decisionBudget = DEFAULT_DECISION_BUDGET;
+
+	// distant tanks due to decide this step
+	std::vector<int> m_due;
 
-	bool m_patrolDestinationGenerated = false;
+	// the vision cones of the tanks looking this step, in tank order, and whether each saw the player
+	std::vector<SightQuery> m_cones;
+	std::unique_ptr<bool[]> m_seen;
+
+	Stats m_stats;
 
 	// Vision cone vector...initially points along the x axis.
 	sf::Vector2f m_visionConeDir{ 1, 0 };
 
-	// Vision cone visualisation...vision cone origin
-	sf::Vector2f m_visionConeLeft;
+	// how close the tank has to get to a waypoint before driving on to the next
+	static float constexpr WAYPOINT_REACHED{ 24.0f };
 
-	sf::Vector2f m_visionConeRight;
+	// The maximum see ahead range.
+	static float constexpr MAX_SEE_AHEAD{ 50.0f };
 
-	thor::Arrow m_arrowLeft;
-	thor::Arrow m_arrowRight;
+	// The maximum avoidance turn rate.
+	static float constexpr MAX_AVOID_FORCE{ 50.0f };
+
+	static float constexpr MAX_FORCE{ 10.0f };
+
+	static float constexpr MASS{ 10.0f };
+
+	// the most tanks steered by one pool task, fewer tanks than this are steered on the calling thread
+	static constexpr int STEERING_CHUNK = 16;
+
+	// the distance within which a patrolling tank looks and decides every step, twice the
+	// patrol cone length so the player can not get into a cone between two looks
+	static constexpr float NEAR_PLAYER_DISTANCE = 400.0f;
+
+	// The maximum speed for this tank.
+	float MAX_SPEED = 50.0f;
+
+	// The circles that represent the obstacles to avoid, and a grid to find the ones near a point.
+	std::vector<ObstacleCircle> m_obstacles;
+	SpatialGrid m_obstacleGrid;
+	static constexpr float OBSTACLE_GRID_CELL_SIZE = 64.0f;
 
-	float m_visionConeSweepAngle = 0;
+	// the obstacles drawn for debugging, empty until drawing is first turned on
+	std::vector<sf::CircleShape> m_obstacleShapes;
+	bool m_showObstacles = false;
 
 	// various vision cone lengths for each mode
 	float visionConeLengthPatrol{ 200.0f };
@@ -147,11 +399,8 @@ private:
 	float visionConeAngleAttack{ 20.0f };
 	float visionConeAnglePlayerHalfway{ 40.0f };
 
-	// timer that controls the rate of fire of the tank
-	thor::Timer m_firingTimer;
 	static constexpr float FIRING_COOLDOWN = 2.0f;
 
-	thor::Timer m_backToPatrolDelay;
 	static constexpr float DELAY = 3.0f;
 
 };
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// @brief Packs many images into a few large textures, so sprites from different images can
+///  be drawn without switching textures.
+///
+/// Images are added by name, then build() loads them and packs them onto pages in rows
+///  (shelves): the first image added goes at the top left of the first page, so rects
+///  already measured within it stay valid, and the rest follow tallest first. A new page is
+///  only started when an image does not fit on the current one.
+/// The atlas can be moved, the page textures stay where they are.
+/// Example usage:
+///		TextureAtlas atlas;
+///		atlas.add("SpriteSheet", "./resources/images/SpriteSheet.png");
+///		atlas.add("target", "./resources/images/target.png");
+///		atlas.build();
+///		sprite.setTexture(atlas.texture("target"));
+///		sprite.setTextureRect(atlas.rect("target"));
+/// </summary>
+class TextureAtlas
+{
+public:
+	// largest page width and height, smaller if the graphics card can not take it
+	static constexpr unsigned MAX_PAGE_SIZE = 4096;
+
+	// empty pixels left between images, so they do not bleed into each other
+	static constexpr unsigned PADDING = 1;
+
+	/// <summary>
+	/// @brief Adds an image to be packed by the next build().
+	/// </summary>
+	/// <param name="t_name">The name the image is looked up by</param>
+	/// <param name="t_fileName">The image file to load</param>
+	void add(std::string const& t_name, std::string const& t_fileName);
+
+	/// <summary>
+	/// @brief Loads and packs every image added so far.
+	/// An exception is thrown if an image can not be loaded or is larger than a page.
+	/// </summary>
+	void build();
+
+	// the page an image was packed onto
+	sf::Texture const& texture(std::string const& t_name) const;
+
+	// where an image is on its page
+	sf::IntRect rect(std::string const& t_name) const;
+
+	int pageCount() const;
+
+private:
+	struct Region
+	{
+		int m_page = 0;
+		sf::IntRect m_rect;
+	};
+
+	Region const& region(std::string const& t_name) const;
+
+	// names and files in the order they were added
+	std::vector<std::pair<std::string, std::string>> m_files;
+
+	std::map<std::string, Region> m_regions;
+
+	// the textures are held by pointer, so references to them survive a move of the atlas
+	std::vector<std::unique_ptr<sf::Texture>> m_pages;
+};
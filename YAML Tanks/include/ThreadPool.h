@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// @brief A work stealing thread pool.
+///
+/// Every worker has its own task queue. Workers take tasks from the back of their own
+///  queue and, when it runs dry, steal from the front of the other workers' queues, so
+///  uneven tasks (e.g. matches that end early) still keep every core busy.
+/// Example usage:
+///		ThreadPool pool;
+///		for (int i = 0; i < 100; i++) pool.submit([i] { runMatch(i); });
+///		pool.wait();
+/// </summary>
+class ThreadPool
+{
+public:
+	/// <summary>
+	/// @brief Starts the worker threads.
+	/// </summary>
+	/// <param name="t_threadCount">Number of workers, 0 means one per hardware thread</param>
+	explicit ThreadPool(unsigned t_threadCount = 0);
+
+	// stops the workers once all queued tasks have run
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// <summary>
+	/// @brief Queues a task. Tasks submitted from a worker go to that worker's own queue,
+	///  others are spread over the queues in turn.
+	/// </summary>
+	/// <param name="t_task">The task to run</param>
+	void submit(std::function<void()> t_task);
+
+	/// <summary>
+	/// @brief Blocks until every submitted task has finished.
+	/// Must be called from outside the pool. If a task threw an exception,
+	///  the first one is rethrown here.
+	/// </summary>
+	void wait();
+
+	unsigned threadCount() const;
+
+private:
+	struct WorkQueue
+	{
+		std::mutex m_mutex;
+		std::deque<std::function<void()>> m_tasks;
+	};
+
+	void workerLoop(unsigned t_index);
+
+	// takes a task from the worker's own queue, or steals one from another worker
+	bool popTask(unsigned t_index, std::function<void()>& t_task);
+
+	void runTask(std::function<void()>& t_task);
+
+	std::vector<std::unique_ptr<WorkQueue>> m_queues;
+	std::vector<std::thread> m_threads;
+
+	// guards sleeping and waking, and the stop flag
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_idle;
+	bool m_stopping = false;
+
+	// tasks sitting in a queue
+	std::atomic<int> m_queued{ 0 };
+
+	// tasks submitted but not yet finished
+	std::atomic<int> m_pending{ 0 };
+
+	// queue that the next task from outside the pool goes to
+	std::atomic<unsigned> m_nextQueue{ 0 };
+
+	std::exception_ptr m_error;
+};
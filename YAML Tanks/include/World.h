@@ -0,0 +1,227 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "LevelLoader.h"
+#include "Tank.h"
+#include "TankAI.h"
+#include "Bullet.h"
+#include "SimClock.h"
+#include "Random.h"
+#include "StaticColliders.h"
+#include "Raycaster.h"
+#include "LineOfSight.h"
+#include "NavGrid.h"
+#include "PathQueue.h"
+#include "FlowField.h"
+#include "Globals.h"
+#include "GameState.h"
+#include "InputCommand.h"
+#include "SimEvents.h"
+#include "cargoMode.h"
+
+/// <summary>
+/// @brief The simulation core of the game.
+///
+/// Holds all of the world state (level data, walls, targets, the player and AI tanks and the cargo mode
+///  pickups) and advances it one step at a time. It never opens a window, loads a texture or
+///  plays a sound, so it can be driven either by Game or by a headless runner.
+/// Example usage:
+///		sf::Texture noTexture;
+///		World world(noTexture, noTexture, 1, seed);
+///		world.step(10.0, input);
+/// </summary>
+class World
+{
+public:
+	/// <summary>
+	/// @brief Loads the level and builds the wall and target sprites.
+	/// The supplied textures are only referenced by the sprites, so they may be left
+	///  unloaded when the world is never drawn.
+	/// </summary>
+	/// <param name="t_spriteSheet">A reference to the sprite sheet texture</param>
+	/// <param name="t_targetTexture">A reference to the target texture</param>
+	/// <param name="t_levelNr">The level number to load</param>
+	/// <param name="t_seed">Seeds all of the randomness in this world, the same seed and inputs replay the same match</param>
+	World(sf::Texture const& t_spriteSheet, sf::Texture const& t_targetTexture, int t_levelNr, std::uint64_t t_seed);
+
+	// the tanks hold references into the world, so it can not be copied
+	World(World const&) = delete;
+	World& operator=(World const&) = delete;
+
+	/// <summary>
+	/// @brief Advances the whole simulation by one step.
+	/// Events raised during the step are available from m_events until the next call.
+	/// </summary>
+	/// <param name="dt">update delta time in milliseconds</param>
+	/// <param name="t_input">The player input for this step</param>
+	void step(double dt, InputCommand const& t_input);
+
+	/// <summary>
+	/// @brief Adds the targets, tanks, pickups and bullets to the batch.
+	/// Moving objects are drawn blended between the previous and current step.
+	/// </summary>
+	/// <param name="t_batch">The batch the sprites are added to</param>
+	/// <param name="alpha">How far the frame is between the previous and current step (0 to 1)</param>
+	void render(SpriteBatch& t_batch, float alpha);
+
+	// draws the AI vision cones and debug shapes, after the batch from render() has been drawn
+	void renderOverlay(sf::RenderTarget& t_target, float alpha);
+
+	/// <summary>
+	/// @brief Sets where the target image is in the target texture, for a texture holding several images.
+	/// The target boxes were built from the image size, so the size must stay the same.
+	/// </summary>
+	/// <param name="t_rect">The target image's rect in the target texture</param>
+	void setTargetTextureRect(sf::IntRect const& t_rect);
+
+	// draws the parts of the world that never move (the walls), drawn before render() and
+	// usually cached by a StaticLayer
+	void renderStatic(sf::RenderTarget& t_target) const;
+
+	/// <summary>
+	/// @brief Saves a snapshot of everything that changes during a match.
+	/// Loading it into a world created with the same level and seed puts that world
+	///  in exactly the same state, used for replay keyframes.
+	/// </summary>
+	/// <param name="t_writer">Where the snapshot is written</param>
+	void saveState(StateWriter& t_writer) const;
+
+	/// <summary>
+	/// @brief Restores a snapshot taken by saveState().
+	/// An exception is thrown if the snapshot does not match the loaded level.
+	/// </summary>
+	/// <param name="t_reader">The snapshot to read</param>
+	void loadState(StateReader& t_reader);
+
+	// simulation time, advanced by every step and driving all of the game timers
+	SimClock m_clock;
+
+	// the only source of randomness in the simulation, never shared with another world
+	Random m_random;
+
+	// the seed the world was created with
+	std::uint64_t m_seed;
+
+	LevelData m_level;
+
+	// sprites for obstacles
+	std::vector<sf::Sprite> m_wallSprites;
+
+	// the wall sprites baked into textured triangles, so every wall is drawn in one call
+	sf::VertexArray m_wallVertices;
+
+	// baked wall boxes and their broad phase grid, built once the walls are generated
+	StaticColliders m_walls;
+
+	// sprites for targets
+	std::vector<sf::Sprite> m_targetSprites;
+
+	// baked collision boxes for the targets, one per target sprite
+	std::vector<OrientedBoundingBox> m_targetBoxes;
+
+	// ray and line of sight queries against the walls, targets and tanks
+	Raycaster m_raycaster;
+
+	// vision cone checks for the AI, built on the raycaster
+	LineOfSight m_lineOfSight;
+
+	// walkable cells for AI path finding, baked from the walls
+	NavGrid m_navGrid;
+
+	// the AI's path searches, run between steps so they never hold one up
+	PathQueue m_paths;
+
+	// the way to the player tank from every cell, shared by all chasing AI tanks
+	FlowField m_flowField;
+
+	// An instance representing the player controlled tank.
+	Tank m_tank;
+
+	// the ai controlled tanks declared by the level
+	TankAi m_aiTanks;
+
+	// instance representing fuel pickup, base goal and cargo pickup
+	cargoMode m_cargoMode;
+
+	// The initial game state set to GAME_RUNNING
+	GameState m_gameState{ GameState::GAME_RUNNING };
+
+	// events raised during the last step
+	SimEvents m_events;
+
+	// string containing current objective
+	std::string m_objectiveString = "Collect the Ammo!";
+
+	// game time remaining, in seconds
+	int m_timeRemaining = 0;
+
+	// time remaining on the current target, in seconds
+	int m_remainingTime = 0;
+
+	// control when to display indictator of target about to vanish
+	bool m_targetVanishing = false;
+
+	// index of the target that is about to vanish
+	int m_vanishingTarget = 0;
+
+	int m_playerScore = 0;
+	float m_targetsHit = 0;
+	float m_accuracy = 0;
+
+	static constexpr float TIMER_DURATION = 60.0f;
+
+	// size of a wall grid cell, about twice the size of a wall
+	static constexpr float WALL_GRID_CELL_SIZE = 64.0f;
+
+	// size of a navigation cell, and how far the AI tanks' paths keep from the walls
+	// (about half the width of the tank)
+	static constexpr float NAV_CELL_SIZE = 16.0f;
+	static constexpr float NAV_CLEARANCE = 12.0f;
+
+private:
+	/// <summary>
+	/// @brief Creates the wall sprites and loads them into a vector.
+	/// Note that sf::Sprite is considered a light weight class, so
+	///  storing copies (instead of pointers to sf::Sprite) in std::vector is acceptable.
+	/// </summary>
+	void generateWalls();
+
+	// builds m_wallVertices from the wall sprites, two triangles per wall
+	void bakeWallVertices();
+
+	// generates targets and loads them into a vector like generateWalls() does with wall sprites
+	void generateTargets();
+
+	// size of target.png, so targets can be hit without the texture being loaded
+	static constexpr int TARGET_SIZE = 30;
+
+	// check cargo and fuel pickups and delivery to the base
+	void updateCargoMode();
+
+	// activate, expire and score the targets
+	void updateTargets();
+
+	//check remaining time of current target. if it has less than 5 seconds of being active,
+	// flag it as vanishing
+	void remainingTargetTime(int i);
+	// check if target was shot. If it was, reset timer with the remaining time of the previous target added on as reward
+	void targetShot(int i);
+	// check if target has expired (time to shoot it has run out) if it was, spawn next target
+	void genNextTarget(int i);
+
+	// updates the game time remaining and ends the game when it runs out
+	void updateGameTimer();
+
+	// A reference to the sprite sheet texture
+	sf::Texture const& m_texture;
+
+	// A reference to the target texture
+	sf::Texture const& m_targetTexture;
+
+	// timer used for in game time, where upon reaching 0 the game is over
+	// timer is in seconds
+	SimTimer m_timer;
+
+	// timer used for targets, in seconds
+	SimTimer m_targetTimer;
+};
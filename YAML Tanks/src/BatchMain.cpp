@@ -0,0 +1,244 @@
+#include "World.h"
+#include "PlayerBot.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Simulation step used by the batch runner, matches Game's notional update time
+static double const MS_PER_UPDATE = 10.0;
+
+// A match is stopped after this many ticks even if it has not ended (60 seconds plus some slack)
+static long const MATCH_TICK_LIMIT = static_cast<long>(World::TIMER_DURATION * 1000.0 / MS_PER_UPDATE) + 100;
+
+/// <summary>
+/// @brief Command line settings for a batch run.
+/// </summary>
+struct BatchOptions
+{
+	int m_matches = 1000;
+	std::string m_output = "batch_results.csv";
+	unsigned m_threads = 0;
+	unsigned m_seed = 1;
+	int m_level = 1;
+	PlayerBot::Mode m_player = PlayerBot::Mode::AI;
+};
+
+/// <summary>
+/// @brief The outcome of one match.
+/// </summary>
+struct MatchResult
+{
+	int m_match = 0;
+	unsigned m_seed = 0;
+	long m_ticks = 0;
+	int m_score = 0;
+	int m_targetsHit = 0;
+	int m_bulletsFired = 0;
+	float m_accuracy = 0;
+	double m_fuel = 0;
+	GameState m_state = GameState::GAME_RUNNING;
+};
+
+/// <summary>
+/// @brief Plays one complete match in its own world.
+/// </summary>
+/// <param name="t_options">The batch settings</param>
+/// <param name="t_match">The match number, used to derive the match seed</param>
+/// <param name="t_noTexture">An unloaded texture shared by all the worlds</param>
+/// <returns>The result of the match.</returns>
+MatchResult runMatch(BatchOptions const& t_options, int t_match, sf::Texture const& t_noTexture)
+{
+	MatchResult result;
+	result.m_match = t_match;
+	result.m_seed = t_options.m_seed + t_match;
+
+	World world(t_noTexture, t_noTexture, t_options.m_level, result.m_seed);
+	PlayerBot bot(t_options.m_player);
+
+	while (world.m_gameState == GameState::GAME_RUNNING && result.m_ticks < MATCH_TICK_LIMIT)
+	{
+		world.step(MS_PER_UPDATE, bot.nextInput(world));
+		result.m_ticks++;
+	}
+
+	result.m_score = world.m_playerScore;
+	result.m_targetsHit = static_cast<int>(world.m_targetsHit);
+	result.m_bulletsFired = static_cast<int>(world.m_tank.m_bulletsFired);
+	if (world.m_tank.m_bulletsFired != 0)
+	{
+		result.m_accuracy = (world.m_targetsHit / world.m_tank.m_bulletsFired) * 100;
+	}
+	result.m_fuel = world.m_tank.m_fuel;
+	result.m_state = world.m_gameState;
+
+	return result;
+}
+
+std::string stateName(GameState t_state)
+{
+	switch (t_state)
+	{
+	case GameState::GAME_WIN:
+		return "win";
+	case GameState::GAME_LOSE:
+		return "lose";
+	default:
+		return "running";
+	}
+}
+
+/// <summary>
+/// @brief Writes the results as one JSON object per line if the file name ends in .jsonl,
+///  otherwise as CSV with a header row.
+/// </summary>
+void writeResults(std::string const& t_fileName, std::vector<MatchResult> const& t_results)
+{
+	std::ofstream outputFile(t_fileName);
+	if (!outputFile.is_open())
+	{
+		throw std::runtime_error("Could not open " + t_fileName + " for writing");
+	}
+
+	bool jsonLines = t_fileName.size() >= 6 && t_fileName.compare(t_fileName.size() - 6, 6, ".jsonl") == 0;
+
+	if (!jsonLines)
+	{
+		outputFile << "match,seed,ticks,score,targetsHit,bulletsFired,accuracy,fuel,state\n";
+	}
+
+	for (MatchResult const& result : t_results)
+	{
+		if (jsonLines)
+		{
+			outputFile << "{\"match\":" << result.m_match
+				<< ",\"seed\":" << result.m_seed
+				<< ",\"ticks\":" << result.m_ticks
+				<< ",\"score\":" << result.m_score
+				<< ",\"targetsHit\":" << result.m_targetsHit
+				<< ",\"bulletsFired\":" << result.m_bulletsFired
+				<< ",\"accuracy\":" << result.m_accuracy
+				<< ",\"fuel\":" << result.m_fuel
+				<< ",\"state\":\"" << stateName(result.m_state) << "\"}\n";
+		}
+		else
+		{
+			outputFile << result.m_match << ','
+				<< result.m_seed << ','
+				<< result.m_ticks << ','
+				<< result.m_score << ','
+				<< result.m_targetsHit << ','
+				<< result.m_bulletsFired << ','
+				<< result.m_accuracy << ','
+				<< result.m_fuel << ','
+				<< stateName(result.m_state) << '\n';
+		}
+	}
+}
+
+void printUsage()
+{
+	std::cout << "Usage: tank_batch [-n matches] [-o results.csv|results.jsonl] [-j threads]\n"
+		<< "                  [-s seed] [-l level] [-p ai|script]\n";
+}
+
+bool parseOptions(int argc, char* argv[], BatchOptions& t_options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (i + 1 >= argc)
+		{
+			return false;
+		}
+
+		char const* value = argv[i + 1];
+		if (std::strcmp(argv[i], "-n") == 0)
+		{
+			t_options.m_matches = std::atoi(value);
+		}
+		else if (std::strcmp(argv[i], "-o") == 0)
+		{
+			t_options.m_output = value;
+		}
+		else if (std::strcmp(argv[i], "-j") == 0)
+		{
+			t_options.m_threads = static_cast<unsigned>(std::atoi(value));
+		}
+		else if (std::strcmp(argv[i], "-s") == 0)
+		{
+			t_options.m_seed = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "-l") == 0)
+		{
+			t_options.m_level = std::atoi(value);
+		}
+		else if (std::strcmp(argv[i], "-p") == 0)
+		{
+			t_options.m_player = (std::strcmp(value, "script") == 0) ? PlayerBot::Mode::SCRIPTED : PlayerBot::Mode::AI;
+		}
+		else
+		{
+			return false;
+		}
+		i++;
+	}
+	return true;
+}
+
+/// <summary>
+/// @brief Entry point for the batch match runner.
+///
+/// Plays many independent matches, each in its own world, on a work stealing thread pool
+///  with one worker per core, then writes a result row per match.
+/// </summary>
+int main(int argc, char* argv[])
+{
+	BatchOptions options;
+	if (!parseOptions(argc, argv, options) || options.m_matches <= 0)
+	{
+		printUsage();
+		return 1;
+	}
+
+	// never loaded, the sprites only need texture rects for collision
+	sf::Texture noTexture;
+
+	std::vector<MatchResult> results(options.m_matches);
+
+	try
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		ThreadPool pool(options.m_threads);
+		for (int i = 0; i < options.m_matches; i++)
+		{
+			// each task writes only its own slot, so no locking is needed
+			pool.submit([&options, &results, &noTexture, i]
+			{
+				results[i] = runMatch(options, i, noTexture);
+			});
+		}
+		pool.wait();
+
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		writeResults(options.m_output, results);
+
+		std::cout << "Matches: " << options.m_matches << " on " << pool.threadCount() << " threads\n";
+		std::cout << "Elapsed: " << elapsed.count() << " s\n";
+		std::cout << "Matches per second: " << (elapsed.count() > 0 ? options.m_matches / elapsed.count() : 0) << "\n";
+		std::cout << "Results written to " << options.m_output << "\n";
+	}
+	catch (std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,43 @@
+#include "BoxBatch.h"
+
+////////////////////////////////////////////////////////////
+void BoxBatch::clear()
+{
+	for (int i = 0; i < 4; i++)
+	{
+		m_cornerX[i].clear();
+		m_cornerY[i].clear();
+	}
+	for (int i = 0; i < 2; i++)
+	{
+		m_axisX[i].clear();
+		m_axisY[i].clear();
+		m_axisMin[i].clear();
+		m_axisMax[i].clear();
+	}
+	m_size = 0;
+}
+
+////////////////////////////////////////////////////////////
+void BoxBatch::add(OrientedBoundingBox const& t_box)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		m_cornerX[i].push_back(t_box.Points[i].x);
+		m_cornerY[i].push_back(t_box.Points[i].y);
+	}
+	for (int i = 0; i < 2; i++)
+	{
+		m_axisX[i].push_back(t_box.Axes[i].x);
+		m_axisY[i].push_back(t_box.Axes[i].y);
+		m_axisMin[i].push_back(t_box.AxisMin[i]);
+		m_axisMax[i].push_back(t_box.AxisMax[i]);
+	}
+	m_size++;
+}
+
+////////////////////////////////////////////////////////////
+int BoxBatch::size() const
+{
+	return m_size;
+}
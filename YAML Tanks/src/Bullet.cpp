@@ -2,6 +2,8 @@
 #include "MathUtility.h"
 #include "ScreenSize.h"
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 // blank default constructor as properites are defined in header
 Bullet::Bullet()
@@ -31,23 +33,56 @@ void Bullet::findStartPoint(double t_turretRotation, sf::Vector2f t_turretSprite
 
 void Bullet::update(double dt)
 {
-		m_bulletSprite.move(m_startPoint.x * PROJECTILE_SPEED * (dt / 1000),
-			m_startPoint.y * PROJECTILE_SPEED * (dt / 1000));
+		// remember where the step started, collisions are checked along the whole path
+		m_sweepBox.set(m_bulletSprite);
+		m_sweepDisplacement = sf::Vector2f(static_cast<float>(m_startPoint.x * PROJECTILE_SPEED * (dt / 1000)),
+			static_cast<float>(m_startPoint.y * PROJECTILE_SPEED * (dt / 1000)));
+		m_wallImpactFound = false;
 
-		// check if bullet has gone off screen
-		if (checkGameWorldBoundaries())
-		{
-			m_bulletSprite.setPosition(m_offScreenPosition);
-			m_bulletSprite.setRotation(270);
-			m_canFire = true;
-			m_traveling = false;
-		}
-	
+		m_bulletSprite.move(m_sweepDisplacement);
 }
 
-void Bullet::render(sf::RenderWindow& window)
+void Bullet::render(SpriteBatch& t_batch, float alpha)
 {
-	window.draw(m_bulletSprite);
+	if (!m_traveling)
+	{
+		return;
+	}
+
+	if (m_renderTraveling)
+	{
+		sf::Sprite bullet = m_bulletSprite;
+		bullet.setPosition(MathUtility::lerp(m_renderPosition, m_bulletSprite.getPosition(), alpha));
+		t_batch.draw(bullet, DrawLayer::BULLETS);
+	}
+	else
+	{
+		t_batch.draw(m_bulletSprite, DrawLayer::BULLETS);
+	}
+}
+
+void Bullet::storePreviousState()
+{
+	m_renderPosition = m_bulletSprite.getPosition();
+	m_renderTraveling = m_traveling;
+}
+
+void Bullet::saveState(StateWriter& t_writer) const
+{
+	t_writer.writeSprite(m_bulletSprite);
+	t_writer.writeVector(m_startPoint);
+	t_writer.write(m_canFire);
+	t_writer.write(m_firing);
+	t_writer.write(m_traveling);
+}
+
+void Bullet::loadState(StateReader& t_reader)
+{
+	t_reader.readSprite(m_bulletSprite);
+	m_startPoint = t_reader.readVector();
+	t_reader.read(m_canFire);
+	t_reader.read(m_firing);
+	t_reader.read(m_traveling);
 }
 
 void Bullet::setPosition(sf::Vector2f& position)
@@ -55,11 +90,11 @@ void Bullet::setPosition(sf::Vector2f& position)
 	m_bulletSprite.setPosition(position);
 }
 
-void Bullet::handleKeyInputs()
+void Bullet::handleKeyInputs(InputCommand const& t_input)
 {
 	if (m_canFire)
 	{
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space))
+		if (t_input.m_fire)
 		{
 			m_firing = true;
 			m_canFire = false;
@@ -68,36 +103,75 @@ void Bullet::handleKeyInputs()
 	}
 }
 
-void Bullet::wallCollision(std::vector<sf::Sprite>& t_wallSprites)
+float Bullet::wallImpactTime(StaticColliders const& t_walls)
 {
-	for (sf::Sprite const& sprite : t_wallSprites)
+	if (!m_wallImpactFound)
 	{
-		//	Checks if bullet sprite has collided with any walls, if it has reset that bullet
-		if (CollisionDetector::collision(m_bulletSprite, sprite))
+		// only the walls overlapping the area the bullet swept through can be hit
+		sf::FloatRect start = m_sweepBox.getBounds();
+		sf::FloatRect path(std::min(start.left, start.left + m_sweepDisplacement.x),
+			std::min(start.top, start.top + m_sweepDisplacement.y),
+			start.width + std::abs(m_sweepDisplacement.x),
+			start.height + std::abs(m_sweepDisplacement.y));
+		t_walls.query(path, m_nearbyWalls);
+
+		m_wallImpact = 2.0f;
+		for (int wall : m_nearbyWalls)
 		{
-			m_wallHitSound.play();
-			m_bulletSprite.setPosition(m_offScreenPosition);
-			m_bulletSprite.setRotation(270);
-			m_canFire = true;
-			m_traveling = false;
-			
+			float time;
+			if (CollisionDetector::sweep(m_sweepBox, m_sweepDisplacement, t_walls.box(wall), time))
+			{
+				m_wallImpact = std::min(m_wallImpact, time);
+			}
 		}
+		m_wallImpactFound = true;
+	}
+	return m_wallImpact;
+}
+
+void Bullet::reset()
+{
+	m_bulletSprite.setPosition(m_offScreenPosition);
+	m_bulletSprite.setRotation(270);
+	m_canFire = true;
+	m_traveling = false;
+}
+
+bool Bullet::wallCollision(StaticColliders const& t_walls)
+{
+	// already stopped by a target this step
+	if (!m_traveling)
+	{
+		return false;
+	}
+
+	//	Checks if the bullet's path crossed any walls, if it has reset that bullet
+	if (wallImpactTime(t_walls) <= 1.0f)
+	{
+		reset();
+		return true;
 	}
+
+	// check if bullet has gone off screen
+	if (checkGameWorldBoundaries())
+	{
+		reset();
+	}
+
+	return false;
 }
 
-void Bullet::targetCollision(std::vector<sf::Sprite>& t_targetSprites, std::vector<TargetData>& t_targets)
+void Bullet::targetCollision(StaticColliders const& t_walls, std::vector<OrientedBoundingBox> const& t_targetBoxes, std::vector<TargetData>& t_targets)
 {
 	for (int i = 0; i < t_targets.size(); i++)
 	{
 		if (t_targets[i].m_active == true)
 		{
-			// get target data and coresponding sprite
-			TargetData const& target = t_targets[i];
-			sf::Sprite const& sprite = t_targetSprites[i];
-
-			//Checks if bullet sprite has collided with active target.
+			//Checks if bullet's path crossed the active target before any wall.
 			//If it has, reset that bullet and destroy that target
-			if (CollisionDetector::collision(m_bulletSprite, sprite))
+			float time;
+			if (CollisionDetector::sweep(m_sweepBox, m_sweepDisplacement, t_targetBoxes[i], time)
+				&& time < wallImpactTime(t_walls))
 			{
 				// destroys target in game.cpp
 				t_targets[i].m_shot = true;
@@ -108,10 +182,7 @@ void Bullet::targetCollision(std::vector<sf::Sprite>& t_targetSprites, std::vect
 					t_targets[i + 1].m_active = true;
 				}
 
-				m_bulletSprite.setPosition(m_offScreenPosition);
-				m_bulletSprite.setRotation(270);
-				m_canFire = true;
-				m_traveling = false;
+				reset();
 
 			}
 
@@ -165,16 +236,3 @@ void Bullet::initBullet(sf::Texture const& t_texture)
 	m_bulletSprite.setRotation(270);
 	m_bulletSprite.setPosition(m_offScreenPosition);
 }
-
-void Bullet::initSounds()
-{
-	if (!m_wallHitBuffer.loadFromFile("./resources/sounds/Explosion.wav"))
-	{
-		std::string s("Error loading explosion (wall hit) sound");
-		throw std::exception(s.c_str());
-	}
-
-	m_wallHitSound.setBuffer(m_wallHitBuffer);
-	m_wallHitSound.setVolume(30.0f);
-}
-
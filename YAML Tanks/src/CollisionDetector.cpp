@@ -1,34 +1,318 @@
 #include "CollisionDetector.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define COLLISION_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only compile AVX intrinsics in functions marked for AVX, MSVC always does
+#if defined(COLLISION_SIMD_X86) && !defined(_MSC_VER)
+#define COLLISION_TARGET_AVX __attribute__((target("avx")))
+#define COLLISION_TARGET_SSE __attribute__((target("sse2")))
+#else
+#define COLLISION_TARGET_AVX
+#define COLLISION_TARGET_SSE
+#endif
 
 bool CollisionDetector::collision(const sf::Sprite& object1, const sf::Sprite& object2) {
-	OrientedBoundingBox OBB1(object1);
-	OrientedBoundingBox OBB2(object2);
+	return collision(OrientedBoundingBox(object1), OrientedBoundingBox(object2));
+}
 
-	// Create the four distinct axes that are perpendicular to the edges of the two rectangles
-	sf::Vector2f Axes[4] = {
-		sf::Vector2f(OBB1.Points[1].x - OBB1.Points[0].x,
-		OBB1.Points[1].y - OBB1.Points[0].y),
-		sf::Vector2f(OBB1.Points[1].x - OBB1.Points[2].x,
-		OBB1.Points[1].y - OBB1.Points[2].y),
-		sf::Vector2f(OBB2.Points[0].x - OBB2.Points[3].x,
-		OBB2.Points[0].y - OBB2.Points[3].y),
-		sf::Vector2f(OBB2.Points[0].x - OBB2.Points[1].x,
-		OBB2.Points[0].y - OBB2.Points[1].y)
-	};
+bool CollisionDetector::collision(const OrientedBoundingBox& OBB1, const OrientedBoundingBox& OBB2) {
+	// The four distinct axes perpendicular to the edges of the two rectangles are the two
+	// edge axes of each box. The projections of the boxes onto their own axes are cached.
+	for (int i = 0; i < 2; i++) // For each axis of the first box...
+	{
+		float MinOBB2, MaxOBB2;
+		OBB2.ProjectOntoAxis(OBB1.Axes[i], MinOBB2, MaxOBB2);
+		// If the projections do not overlap, the Seperating Axis Theorem states that there can be no collision between the rectangles
+		if (!((MinOBB2 <= OBB1.AxisMax[i]) && (MaxOBB2 >= OBB1.AxisMin[i])))
+			return false;
+	}
 
-	for (int i = 0; i<4; i++) // For each axis...
+	for (int i = 0; i < 2; i++) // ... and each axis of the second
 	{
-		float MinOBB1, MaxOBB1, MinOBB2, MaxOBB2;
+		float MinOBB1, MaxOBB1;
+		OBB1.ProjectOntoAxis(OBB2.Axes[i], MinOBB1, MaxOBB1);
+		if (!((OBB2.AxisMin[i] <= MaxOBB1) && (OBB2.AxisMax[i] >= MinOBB1)))
+			return false;
+	}
 
-		// ... project the points of both OBBs onto the axis ...
-		OBB1.ProjectOntoAxis(Axes[i], MinOBB1, MaxOBB1);
-		OBB2.ProjectOntoAxis(Axes[i], MinOBB2, MaxOBB2);
+	return true;	// Collision detected!
+}
 
-		// ... and check whether the outermost projected points of both OBBs overlap.
-		// If this is not the case, the Seperating Axis Theorem states that there can be no collision between the rectangles
-		if (!((MinOBB2 <= MaxOBB1) && (MaxOBB2 >= MinOBB1)))
+// Narrows the window [first, last] to the times at which two intervals moving apart at the given
+// speed along one axis overlap, returns false if they never do during the step
+static bool sweepAxis(float Min1, float Max1, float Min2, float Max2, float speed, float& first, float& last)
+{
+	if (Max1 < Min2) // the first box is behind the second on this axis
+	{
+		if (speed <= 0.f)
 			return false;
+		first = std::max(first, (Min2 - Max1) / speed);
+		last = std::min(last, (Max2 - Min1) / speed);
 	}
+	else if (Max2 < Min1) // ... or in front of it
+	{
+		if (speed >= 0.f)
+			return false;
+		first = std::max(first, (Max2 - Min1) / speed);
+		last = std::min(last, (Min2 - Max1) / speed);
+	}
+	else if (speed > 0.f) // overlapping already, until the first box moves out of the far side
+	{
+		last = std::min(last, (Max2 - Min1) / speed);
+	}
+	else if (speed < 0.f)
+	{
+		last = std::min(last, (Min2 - Max1) / speed);
+	}
+	return first <= last;
+}
 
-	return true;	// Collision detected!
+bool CollisionDetector::sweep(const OrientedBoundingBox& OBB1, const sf::Vector2f& displacement, const OrientedBoundingBox& OBB2, float& time) {
+	float first = 0.f;
+	float last = 1.f;
+
+	for (int i = 0; i < 2; i++) // For each axis of the moving box...
+	{
+		float MinOBB2, MaxOBB2;
+		OBB2.ProjectOntoAxis(OBB1.Axes[i], MinOBB2, MaxOBB2);
+		float speed = displacement.x * OBB1.Axes[i].x + displacement.y * OBB1.Axes[i].y;
+		if (!sweepAxis(OBB1.AxisMin[i], OBB1.AxisMax[i], MinOBB2, MaxOBB2, speed, first, last))
+			return false;
+	}
+
+	for (int i = 0; i < 2; i++) // ... and each axis of the still one
+	{
+		float MinOBB1, MaxOBB1;
+		OBB1.ProjectOntoAxis(OBB2.Axes[i], MinOBB1, MaxOBB1);
+		float speed = displacement.x * OBB2.Axes[i].x + displacement.y * OBB2.Axes[i].y;
+		if (!sweepAxis(MinOBB1, MaxOBB1, OBB2.AxisMin[i], OBB2.AxisMax[i], speed, first, last))
+			return false;
+	}
+
+	time = first;
+	return true;
+}
+
+// Tests OBB1 against box j of the batch, the scalar version of the SIMD kernels below
+static bool collidesWithBatchBox(const OrientedBoundingBox& OBB1, const BoxBatch& batch, int j)
+{
+	for (int i = 0; i < 2; i++) // For each axis of the moving box, project the batch box onto it
+	{
+		float MinOBB2 = batch.m_cornerX[0][j] * OBB1.Axes[i].x + batch.m_cornerY[0][j] * OBB1.Axes[i].y;
+		float MaxOBB2 = MinOBB2;
+		for (int k = 1; k < 4; k++)
+		{
+			float Projection = batch.m_cornerX[k][j] * OBB1.Axes[i].x + batch.m_cornerY[k][j] * OBB1.Axes[i].y;
+			MinOBB2 = std::min(MinOBB2, Projection);
+			MaxOBB2 = std::max(MaxOBB2, Projection);
+		}
+		if (!((MinOBB2 <= OBB1.AxisMax[i]) && (MaxOBB2 >= OBB1.AxisMin[i])))
+			return false;
+	}
+
+	for (int i = 0; i < 2; i++) // For each axis of the batch box, project the moving box onto it
+	{
+		sf::Vector2f Axis(batch.m_axisX[i][j], batch.m_axisY[i][j]);
+		float MinOBB1, MaxOBB1;
+		OBB1.ProjectOntoAxis(Axis, MinOBB1, MaxOBB1);
+		if (!((batch.m_axisMin[i][j] <= MaxOBB1) && (batch.m_axisMax[i][j] >= MinOBB1)))
+			return false;
+	}
+
+	return true;
+}
+
+static std::uint32_t collisionMaskScalar(const OrientedBoundingBox& OBB1, const BoxBatch& batch, int first, int count)
+{
+	std::uint32_t mask = 0;
+	for (int lane = 0; lane < count; lane++)
+	{
+		if (collidesWithBatchBox(OBB1, batch, first + lane))
+		{
+			mask |= 1u << lane;
+		}
+	}
+	return mask;
+}
+
+#ifdef COLLISION_SIMD_X86
+
+COLLISION_TARGET_SSE
+static std::uint32_t collisionMaskSSE(const OrientedBoundingBox& OBB1, const BoxBatch& batch, int first, int count)
+{
+	std::uint32_t mask = 0;
+	int lane = 0;
+	for (; lane + 4 <= count; lane += 4)
+	{
+		int const j = first + lane;
+		__m128 hit = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+		for (int i = 0; i < 2; i++)
+		{
+			__m128 axisX = _mm_set1_ps(OBB1.Axes[i].x);
+			__m128 axisY = _mm_set1_ps(OBB1.Axes[i].y);
+			__m128 minimum = _mm_setzero_ps();
+			__m128 maximum = _mm_setzero_ps();
+			for (int k = 0; k < 4; k++)
+			{
+				__m128 projection = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&batch.m_cornerX[k][j]), axisX),
+					_mm_mul_ps(_mm_loadu_ps(&batch.m_cornerY[k][j]), axisY));
+				minimum = (k == 0) ? projection : _mm_min_ps(minimum, projection);
+				maximum = (k == 0) ? projection : _mm_max_ps(maximum, projection);
+			}
+			hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(minimum, _mm_set1_ps(OBB1.AxisMax[i])),
+				_mm_cmpge_ps(maximum, _mm_set1_ps(OBB1.AxisMin[i]))));
+		}
+
+		for (int i = 0; i < 2; i++)
+		{
+			__m128 axisX = _mm_loadu_ps(&batch.m_axisX[i][j]);
+			__m128 axisY = _mm_loadu_ps(&batch.m_axisY[i][j]);
+			__m128 minimum = _mm_setzero_ps();
+			__m128 maximum = _mm_setzero_ps();
+			for (int k = 0; k < 4; k++)
+			{
+				__m128 projection = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(OBB1.Points[k].x), axisX),
+					_mm_mul_ps(_mm_set1_ps(OBB1.Points[k].y), axisY));
+				minimum = (k == 0) ? projection : _mm_min_ps(minimum, projection);
+				maximum = (k == 0) ? projection : _mm_max_ps(maximum, projection);
+			}
+			hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&batch.m_axisMin[i][j]), maximum),
+				_mm_cmpge_ps(_mm_loadu_ps(&batch.m_axisMax[i][j]), minimum)));
+		}
+
+		mask |= static_cast<std::uint32_t>(_mm_movemask_ps(hit)) << lane;
+	}
+
+	// the last few boxes that do not fill a register
+	return mask | (collisionMaskScalar(OBB1, batch, first + lane, count - lane) << lane);
+}
+
+COLLISION_TARGET_AVX
+static std::uint32_t collisionMaskAVX(const OrientedBoundingBox& OBB1, const BoxBatch& batch, int first, int count)
+{
+	std::uint32_t mask = 0;
+	int lane = 0;
+	for (; lane + 8 <= count; lane += 8)
+	{
+		int const j = first + lane;
+		__m256 hit = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+		for (int i = 0; i < 2; i++)
+		{
+			__m256 axisX = _mm256_set1_ps(OBB1.Axes[i].x);
+			__m256 axisY = _mm256_set1_ps(OBB1.Axes[i].y);
+			__m256 minimum = _mm256_setzero_ps();
+			__m256 maximum = _mm256_setzero_ps();
+			for (int k = 0; k < 4; k++)
+			{
+				__m256 projection = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&batch.m_cornerX[k][j]), axisX),
+					_mm256_mul_ps(_mm256_loadu_ps(&batch.m_cornerY[k][j]), axisY));
+				minimum = (k == 0) ? projection : _mm256_min_ps(minimum, projection);
+				maximum = (k == 0) ? projection : _mm256_max_ps(maximum, projection);
+			}
+			hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(minimum, _mm256_set1_ps(OBB1.AxisMax[i]), _CMP_LE_OQ),
+				_mm256_cmp_ps(maximum, _mm256_set1_ps(OBB1.AxisMin[i]), _CMP_GE_OQ)));
+		}
+
+		for (int i = 0; i < 2; i++)
+		{
+			__m256 axisX = _mm256_loadu_ps(&batch.m_axisX[i][j]);
+			__m256 axisY = _mm256_loadu_ps(&batch.m_axisY[i][j]);
+			__m256 minimum = _mm256_setzero_ps();
+			__m256 maximum = _mm256_setzero_ps();
+			for (int k = 0; k < 4; k++)
+			{
+				__m256 projection = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(OBB1.Points[k].x), axisX),
+					_mm256_mul_ps(_mm256_set1_ps(OBB1.Points[k].y), axisY));
+				minimum = (k == 0) ? projection : _mm256_min_ps(minimum, projection);
+				maximum = (k == 0) ? projection : _mm256_max_ps(maximum, projection);
+			}
+			hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&batch.m_axisMin[i][j]), maximum, _CMP_LE_OQ),
+				_mm256_cmp_ps(_mm256_loadu_ps(&batch.m_axisMax[i][j]), minimum, _CMP_GE_OQ)));
+		}
+
+		mask |= static_cast<std::uint32_t>(_mm256_movemask_ps(hit)) << lane;
+	}
+
+	// the remaining boxes go through the 4 wide path, then the scalar one
+	return mask | (collisionMaskSSE(OBB1, batch, first + lane, count - lane) << lane);
+}
+
+#endif
+
+std::uint32_t CollisionDetector::collisionMask(const OrientedBoundingBox& OBB1, const BoxBatch& batch, int first, int count)
+{
+	return collisionMask(OBB1, batch, first, count, simdLevel());
+}
+
+std::uint32_t CollisionDetector::collisionMask(const OrientedBoundingBox& OBB1, const BoxBatch& batch, int first, int count, SimdLevel level)
+{
+	count = std::min(count, 32);
+
+	switch (level)
+	{
+#ifdef COLLISION_SIMD_X86
+	case SimdLevel::AVX:
+		return collisionMaskAVX(OBB1, batch, first, count);
+
+	case SimdLevel::SSE:
+		return collisionMaskSSE(OBB1, batch, first, count);
+#endif
+
+	default:
+		return collisionMaskScalar(OBB1, batch, first, count);
+	}
+}
+
+bool CollisionDetector::collidesWithAny(const OrientedBoundingBox& OBB1, const BoxBatch& batch)
+{
+	SimdLevel const level = simdLevel();
+	for (int first = 0; first < batch.size(); first += 32)
+	{
+		if (collisionMask(OBB1, batch, first, batch.size() - first, level) != 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// Asks the CPU which instruction sets it has, AVX also needs the operating system to save the wide registers
+static CollisionDetector::SimdLevel detectSimdLevel()
+{
+#ifdef COLLISION_SIMD_X86
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 1);
+	bool const sse2 = (info[3] & (1 << 26)) != 0;
+	bool const avx = (info[2] & (1 << 28)) != 0 && (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+#else
+	__builtin_cpu_init();
+	bool const sse2 = __builtin_cpu_supports("sse2");
+	bool const avx = __builtin_cpu_supports("avx");
+#endif
+	if (avx)
+	{
+		return CollisionDetector::SimdLevel::AVX;
+	}
+	if (sse2)
+	{
+		return CollisionDetector::SimdLevel::SSE;
+	}
+#endif
+	return CollisionDetector::SimdLevel::SCALAR;
+}
+
+CollisionDetector::SimdLevel CollisionDetector::simdLevel()
+{
+	static SimdLevel const level = detectSimdLevel();
+	return level;
 }
@@ -0,0 +1,128 @@
+#include "FlowField.h"
+#include <algorithm>
+#include <limits>
+
+static float const DIAGONAL_COST = 1.41421356f;
+
+////////////////////////////////////////////////////////////
+FlowField::FlowField(NavGrid const& t_grid)
+	: m_grid(t_grid)
+{
+}
+
+////////////////////////////////////////////////////////////
+void FlowField::setGoal(sf::Vector2f t_goal)
+{
+	int const cell = m_grid.nearestWalkable(m_grid.cellOf(t_goal));
+	if (cell != m_goalCell)
+	{
+		m_goalCell = cell;
+		m_dirty = true;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void FlowField::refresh()
+{
+	if (m_goalCell >= 0 && m_dirty)
+	{
+		build();
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool FlowField::direction(sf::Vector2f t_position, sf::Vector2f& t_direction)
+{
+	if (m_goalCell < 0)
+	{
+		return false;
+	}
+	refresh();
+
+	int const cell = m_grid.nearestWalkable(m_grid.cellOf(t_position));
+	if (cell < 0 || m_next[cell] < 0)
+	{
+		return false;
+	}
+
+	t_direction = m_grid.cellCentre(m_next[cell]) - t_position;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+int FlowField::builds() const
+{
+	return m_builds;
+}
+
+////////////////////////////////////////////////////////////
+void FlowField::build()
+{
+	m_dirty = false;
+	m_builds++;
+
+	int const columns = m_grid.columns();
+	int const rows = m_grid.rows();
+	m_distance.assign(m_grid.size(), std::numeric_limits<float>::infinity());
+	m_next.assign(m_grid.size(), -1);
+
+	// the goal cell points at itself, so a tank already there steers to its centre
+	m_distance[m_goalCell] = 0.0f;
+	m_next[m_goalCell] = m_goalCell;
+	m_open.clear();
+	m_open.push_back({ 0.0f, m_goalCell });
+
+	while (!m_open.empty())
+	{
+		std::pop_heap(m_open.begin(), m_open.end(), worse);
+		OpenNode const node = m_open.back();
+		m_open.pop_back();
+		if (node.m_distance > m_distance[node.m_cell])
+		{
+			continue; // a cheaper way to this cell was already found
+		}
+
+		int const column = node.m_cell % columns;
+		int const row = node.m_cell / columns;
+		for (int dy = -1; dy <= 1; dy++)
+		{
+			for (int dx = -1; dx <= 1; dx++)
+			{
+				int const x = column + dx;
+				int const y = row + dy;
+				if ((dx == 0 && dy == 0) || x < 0 || x >= columns || y < 0 || y >= rows)
+				{
+					continue;
+				}
+
+				int const neighbour = y * columns + x;
+				bool const diagonal = (dx != 0 && dy != 0);
+				if (!m_grid.walkable(neighbour) ||
+					(diagonal && (!m_grid.walkable(row * columns + x) || !m_grid.walkable(y * columns + column))))
+				{
+					continue;
+				}
+
+				float const distance = node.m_distance + (diagonal ? DIAGONAL_COST : 1.0f);
+				if (distance < m_distance[neighbour])
+				{
+					// the search runs outwards from the goal, so the way back is towards this cell
+					m_distance[neighbour] = distance;
+					m_next[neighbour] = node.m_cell;
+					m_open.push_back({ distance, neighbour });
+					std::push_heap(m_open.begin(), m_open.end(), worse);
+				}
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool FlowField::worse(OpenNode const& t_a, OpenNode const& t_b)
+{
+	if (t_a.m_distance != t_b.m_distance)
+	{
+		return t_a.m_distance > t_b.m_distance;
+	}
+	return t_a.m_cell > t_b.m_cell;
+}
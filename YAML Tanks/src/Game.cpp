@@ -1,46 +1,26 @@
 #include "Game.h"
 #include <iostream>
-#include "tank.h"
-#include "Bullet.h"
+#include <cmath>
+#include <filesystem>
 
 // Updates per milliseconds
 static double const MS_PER_UPDATE = 10.0;
 
+// Most updates run in one frame before the remaining lag is dropped,
+// stops a slow frame from causing ever more catch up work (spiral of death)
+static int const MAX_UPDATES_PER_FRAME = 10;
+
 ////////////////////////////////////////////////////////////
-Game::Game()
-	: m_window(sf::VideoMode(ScreenSize::s_width, ScreenSize::s_height, 32), "YAML Tanks", sf::Style::Default)
-	, m_tank(m_texture, m_wallSprites, m_targetSprites, m_level.m_targets)
-	, m_aiTank(m_texture, m_wallSprites)
+Game::Game(std::uint64_t t_seed)
+	: m_atlas(loadTextures())
+	, m_world(m_atlas.texture("SpriteSheet"), m_atlas.texture("target"), 1, t_seed)
+	, m_window(sf::VideoMode(ScreenSize::s_width, ScreenSize::s_height, 32), "YAML Tanks", sf::Style::Default)
 	, m_hud(m_font)
 {
-	int currentLevel = 1;
+	setWorldTextures();
 
-	if (!m_texture.loadFromFile("./resources/images/SpriteSheet.png"))
-	{
-		std::string s("Error loading spritesheet");
-		throw std::exception(s.c_str());
-	}
-
-	if (!m_targetTexture.loadFromFile("./resources/images/target.png"))
-	{
-		std::string s("Error loading target texture");
-		throw std::exception(s.c_str());
-	}
-
-	// Will generate an exception if level loading fails.
-	try
-	{
-		LevelLoader::load(currentLevel, m_level);
-	}
-	catch (std::exception& e)
-	{
-		std::cout << "Level Loading failure." << std::endl;
-		std::cout << e.what() << std::endl;
-		throw e;
-	}
-
-	// Now the level data is loaded, set the tank position
-	m_tank.setPosition(m_level.m_tank.m_position);
+	m_world.m_paths.setThreadPool(&m_pathThreads);
+	m_world.m_aiTanks.setThreadPool(&m_aiThreads);
 
 	m_window.setVerticalSyncEnabled(true);
 
@@ -50,20 +30,9 @@ Game::Game()
 		throw std::exception(s.c_str());
 	}
 	m_bgSprite.setTexture(m_bgTexture);
-	
-	// generate the walls and targets in the game
-	generateWalls();
-	generateTargets();
 
-	// timer set to 60 seconds
-	m_timer.reset(sf::Time(sf::seconds(TIMER_DURATION)));
-	// Initiate the timer
-	m_timer.start();
-
-	// target timer set to 10 seconds
-	m_targetTimer.reset(sf::Time(sf::seconds(m_level.m_targets[0].m_duration)));
-	// Initiate the target timer
-	m_targetTimer.start();
+	// the background and walls never move, so they are drawn once and cached
+	m_staticLayer.create(sf::Vector2u(ScreenSize::s_width, ScreenSize::s_height));
 
 	// set up font and texts used in the game
 	setUpFontAndText();
@@ -74,32 +43,47 @@ Game::Game()
 	// read in data from text file (this will not work if the file does not yet exist. In this case, the file is created at game over, then subsequent plays the values stored in the file are read)
 	readTextFile();
 
-	// Populate the obstacle list and set the AI tank position and set up its vision cone
-	m_aiTank.init(m_level.m_aiTank.m_position);
+	// record the session, the seed and the inputs are enough to replay it
+	std::filesystem::create_directories("./replays");
+	m_replay.reset(new ReplayRecorder("./replays/" + std::to_string(t_seed) + ".tkr", 1, t_seed, MS_PER_UPDATE));
 }
 
 ////////////////////////////////////////////////////////////
 void Game::run()
 {
 	sf::Clock clock;
-	sf::Int32 lag = 0;
+	double lag = 0.0;
 
 	while (m_window.isOpen())
 	{
 		sf::Time dt = clock.restart();
 
-		lag += dt.asMilliseconds();
+		// the simulation clock only moves with the steps run here, so pausing
+		// or speeding up the steps pauses or speeds up the whole game
+		if (!m_paused)
+		{
+			lag += dt.asMicroseconds() / 1000.0 * m_timeScale;
+		}
 
 		processEvents();
 
-		while (lag > MS_PER_UPDATE)
+		readInput();
+
+		int updates = 0;
+		while (lag >= MS_PER_UPDATE && updates < MAX_UPDATES_PER_FRAME)
 		{
-			update(lag);
+			update(MS_PER_UPDATE);
 			lag -= MS_PER_UPDATE;
+			updates++;
+		}
+
+		// too far behind to catch up, drop the whole updates that are left
+		if (lag >= MS_PER_UPDATE)
+		{
+			lag = std::fmod(lag, MS_PER_UPDATE);
 		}
-		update(lag);
 
-		render();
+		render(static_cast<float>(lag / MS_PER_UPDATE));
 	}
 }
 
@@ -113,6 +97,7 @@ void Game::processEvents()
 		{
 			m_window.close();
 		}
+		m_keyboard.handleEvent(event);
 		processGameEvents(event);
 	}
 }
@@ -129,96 +114,88 @@ void Game::processGameEvents(sf::Event& event)
 			m_window.close();
 			break;
 
+		case sf::Keyboard::P:
+			m_paused = !m_paused;
+			break;
+
+		case sf::Keyboard::F:
+			m_timeScale = (m_timeScale == 1.0) ? FAST_FORWARD_SCALE : 1.0;
+			break;
+
 		default:
 			break;
 		}
 	}
 }
 
-void Game::generateWalls()
+void Game::readInput()
 {
-	sf::IntRect wallRect(2, 129, 33, 23);
-	// Create the Walls 
-	for (ObstacleData const& obstacle : m_level.m_obstacles)
-	{
-		sf::Sprite sprite;
-		sprite.setTexture(m_texture);
-		sprite.setTextureRect(wallRect);
-		sprite.setOrigin(wallRect.width / 2.0, wallRect.height / 2.0);
-		sprite.setPosition(obstacle.m_position);
-		sprite.setRotation(obstacle.m_rotation);
-		m_wallSprites.push_back(sprite);
-	}
+	m_input = m_keyboard.nextInput(m_world);
 }
 
-void Game::generateTargets()
+void Game::playEventSounds()
 {
-	// Create the targets
-	for (TargetData const& target : m_level.m_targets)
+	SimEvents const& events = m_world.m_events;
+
+	if (events.m_playerShots > 0)
 	{
-		sf::Sprite sprite;
-		sprite.setTexture(m_targetTexture);
-		sprite.setPosition(target.m_position);
-		m_targetSprites.push_back(sprite);
-		
+		m_tankFiringSound.play();
+	}
+	if (events.m_wallHits > 0)
+	{
+		m_wallHitSound.play();
+	}
+	if (events.m_targetsHit > 0)
+	{
+		m_targetHitSound.play();
+	}
+	if (events.m_targetsAppeared > 0)
+	{
+		m_targetAppearSound.play();
 	}
 }
 
-void Game::remainingTargetTime(int i)
+void Game::tankMovingSoundControl()
 {
-	TargetData& target = m_level.m_targets[i];
-
-	m_remainingTime = m_targetTimer.getRemainingTime().asSeconds();
-
-	if (m_remainingTime < 5)
+	// tank moving sound effect
+	// tank is moving, toggle sound
+	if (m_toggleMovingSound && m_world.m_tank.isStopped() == false)
+	{
+		m_tankMovingSound.play();
+		m_toggleMovingSound = false;
+	}
+	// if tank is stopped, pause its sound
+	if (m_world.m_tank.isStopped())
 	{
-		m_targetTimerText.setPosition(target.m_position + sf::Vector2f{ -5,20 });
-		m_targetTimerText.setString(std::to_string(m_remainingTime));
-		m_targetVanishing = true;
+		m_tankMovingSound.pause();
+		m_toggleMovingSound = true;
 	}
 }
 
-void Game::targetShot(int i)
+TextureAtlas Game::loadTextures()
 {
-	TargetData& target = m_level.m_targets[i];
-	
-	m_targetHitSound.play();
-	m_targetTimer.reset(sf::Time(sf::seconds(target.m_duration + m_remainingTime)));
-	m_targetTimer.start();
-	m_targetVanishing = false;
-	target.m_removedFromGame = true;
-	target.m_active = false;
-	m_playerScore += 10;
-	m_targetsHit++;
+	TextureAtlas atlas;
+
+	// the sprite sheet goes first, so it keeps its place at the top left and the texture
+	// rects the tanks, bullets and walls use within it stay the same
+	atlas.add("SpriteSheet", "./resources/images/SpriteSheet.png");
+	atlas.add("target", "./resources/images/target.png");
+	atlas.add("ammoBox", "./resources/images/ammoBox.png");
+	atlas.add("base", "./resources/images/base.png");
+	atlas.add("fuelPickUp", "./resources/images/fuelPickUp.png");
+	atlas.build();
+
+	return atlas;
 }
 
-void Game::genNextTarget(int i)
+void Game::setWorldTextures()
 {
-	TargetData& target = m_level.m_targets[i];
-
-	// prevent trying to access a previous target that doesnt exist
-	if (i > 0)
-	{
-		// if previous target does exist, deactivate it and remove it from the game to prevent it being activated again
-		TargetData& previousTarget = m_level.m_targets[i - 1];
-		previousTarget.m_active = false;
-		previousTarget.m_removedFromGame = true;
-	}
-
-	m_targetAppearSound.play();
-
-	// reset timer and activate new target
-	m_targetTimer.reset(sf::Time(sf::seconds(target.m_duration)));
-	m_targetTimer.start();
-
-	target.m_active = true;
-	// disable target vanishing warning
-	m_targetVanishing = false;
-	
+	m_world.setTargetTextureRect(m_atlas.rect("target"));
+	m_world.m_cargoMode.setTextures(m_atlas.texture("ammoBox"), m_atlas.rect("ammoBox"),
+		m_atlas.texture("base"), m_atlas.rect("base"),
+		m_atlas.texture("fuelPickUp"), m_atlas.rect("fuelPickUp"));
 }
 
-
-
 void Game::setUpFontAndText()
 {
 	if (!m_font.loadFromFile("./resources/fonts/arial.ttf"))
@@ -230,29 +207,6 @@ void Game::setUpFontAndText()
 
 }
 
-void Game::updateGameTimer()
-{
-	// get time remaining as seconds
-    m_timeRemaining = m_timer.getRemainingTime().asSeconds();
-
-	// when game time reaches 0, game is over (stops rendering and updating, displays game over screen)
-	if (m_timer.isExpired())
-	{
-		m_gameState = GameState::GAME_WIN;
-		m_objectiveString = "Time Ran Out!";
-
-		if (m_targetsHit && m_tank.m_bulletsFired != 0)
-		{
-			m_accuracy = ( m_targetsHit / m_tank.m_bulletsFired ) * 100;
-		}
-		else
-		{
-			m_accuracy = 0;
-		}
-	}
-
-}
-
 void Game::setUpEndScreen()
 {
 	m_gameOverText.setFont(m_font);
@@ -262,15 +216,15 @@ void Game::setUpEndScreen()
 
 	m_gameOverText.setString("GAME OVER.Targets hit: " 
 
-		+ std::to_string(static_cast<int>(m_targetsHit)) 
-		+ " / " + std::to_string(static_cast<int>(m_level.m_targets.size())) + "\n"
-		+ "Bullets Fired: " + std::to_string(static_cast<int>(m_tank.m_bulletsFired)) + "\n"
-		+ "Accuracy: " + std::to_string(static_cast<int> (m_accuracy)) + "%" + "\n"
-		+ "Score: " + std::to_string(static_cast<int> (m_playerScore)) + "\n" + "\n"
+		+ std::to_string(static_cast<int>(m_world.m_targetsHit)) 
+		+ " / " + std::to_string(static_cast<int>(m_world.m_level.m_targets.size())) + "\n"
+		+ "Bullets Fired: " + std::to_string(static_cast<int>(m_world.m_tank.m_bulletsFired)) + "\n"
+		+ "Accuracy: " + std::to_string(static_cast<int> (m_world.m_accuracy)) + "%" + "\n"
+		+ "Score: " + std::to_string(static_cast<int> (m_world.m_playerScore)) + "\n" + "\n"
 		+ "BEST PERFORMANCE:" + "\n"
 		+ "Targets Hit: " + std::to_string(static_cast<int>(m_highestTargetsHit))
-		+ " / " + std::to_string(static_cast<int>(m_level.m_targets.size())) + "\n"
-		+ "Bullets Fired: " + std::to_string(static_cast<int>(m_tank.m_bulletsFiredHighScore)) + "\n"
+		+ " / " + std::to_string(static_cast<int>(m_world.m_level.m_targets.size())) + "\n"
+		+ "Bullets Fired: " + std::to_string(static_cast<int>(m_world.m_tank.m_bulletsFiredHighScore)) + "\n"
 		+ "Accuracy: " + std::to_string(static_cast<int> (m_accuracyOfHighScore)) + "%" + "\n"
 		+ "Score: " + std::to_string(static_cast<int> (m_highestPlayerScore)) + "\n");
 
@@ -287,10 +241,10 @@ void Game::writeText()
 	outputFile.open("highScore.txt"); // creates or replaces the file
 
 	// writes to the file
-	outputFile << m_playerScore << "\n";
-	outputFile << m_tank.m_bulletsFired << "\n";
-	outputFile << m_targetsHit << "\n";
-	outputFile << m_accuracy << "\n";
+	outputFile << m_world.m_playerScore << "\n";
+	outputFile << m_world.m_tank.m_bulletsFired << "\n";
+	outputFile << m_world.m_targetsHit << "\n";
+	outputFile << m_world.m_accuracy << "\n";
 
 	outputFile.close(); // close the file stream
 	std::cout << std::endl << "Write successful" << std::endl;
@@ -309,7 +263,7 @@ void Game::readTextFile()
 	if (inputFile.is_open()) // check if file was opened
 	{
 		inputFile >> m_highestPlayerScore;
-		inputFile >> m_tank.m_bulletsFiredHighScore;
+		inputFile >> m_world.m_tank.m_bulletsFiredHighScore;
 		inputFile >> m_highestTargetsHit;
 		inputFile >> m_accuracyOfHighScore;
 		inputFile.close(); // close the file stream
@@ -344,103 +298,60 @@ void Game::initSounds()
 
 	m_targetAppearSound.setBuffer(m_targetAppearBuffer);
 	m_targetAppearSound.setVolume(30.0f);
-}
 
+	if (!m_tankFiringBuffer.loadFromFile("./resources/sounds/TankFiring.wav"))
+	{
+		std::string s("Error loading tank firing sound");
+		throw std::exception(s.c_str());
+	}
 
+	m_tankFiringSound.setBuffer(m_tankFiringBuffer);
+	m_tankFiringSound.setVolume(10.0f);
 
-////////////////////////////////////////////////////////////
-void Game::update(double dt)
-{
+	if (!m_tankMovingBuffer.loadFromFile("./resources/sounds/TankMoving.wav"))
+	{
+		std::string s("Error loading tank moving sound");
+		throw std::exception(s.c_str());
+	}
 
-	m_hud.update(m_gameState,m_timeRemaining, m_tank.m_fuel, m_playerScore, m_objectiveString);
+	m_tankMovingSound.setBuffer(m_tankMovingBuffer);
+	m_tankMovingSound.setVolume(5.0f);
+	m_tankMovingSound.setLoop(true);
 
-	if (m_aiTank.collidesWithPlayer(m_tank))
+	if (!m_wallHitBuffer.loadFromFile("./resources/sounds/Explosion.wav"))
 	{
-		m_gameState = GameState::GAME_LOSE;
+		std::string s("Error loading explosion (wall hit) sound");
+		throw std::exception(s.c_str());
 	}
 
-	switch (m_gameState)
-	{
-	case GameState::GAME_RUNNING:
+	m_wallHitSound.setBuffer(m_wallHitBuffer);
+	m_wallHitSound.setVolume(30.0f);
+}
 
-		m_tank.update(dt);
 
-		if (m_tank.m_fuel <= 0)
-		{
-			m_gameState = GameState::GAME_LOSE;
-		}
 
-		m_aiTank.update(m_tank, dt);
+////////////////////////////////////////////////////////////
+void Game::update(double dt)
+{
+	m_hud.update(m_world.m_gameState, m_world.m_timeRemaining, m_world.m_tank.m_fuel, m_world.m_playerScore, m_world.m_objectiveString);
 
-		// check cargo mode logic
-		// cargo not picked up yet
-		if (m_cargoMode.m_cargoCollected == false)
-		{
-			if (m_cargoMode.playerPicksUpCargo(m_tank))
-			{
-				m_cargoMode.m_cargoCollected = true;
-				m_objectiveString = "Deliver Ammo To Base!";
-			}
-		}
-		else // cargo picked up, check if player is at goal
-		{
-			if (m_cargoMode.playerArrivesAtGoal(m_tank))
-			{
-				m_objectiveString = "Delivered Cargo!";
-				m_gameState = GameState::GAME_WIN;
-			}
-		}
-		
-		// fuel not picked up yet
-		if (m_cargoMode.m_fuelPickedUp == false)
-		{
-			// player is on fuel pickup
-			if (m_cargoMode.playerPicksUpFuel(m_tank))
-			{
-				m_tank.m_fuel += 1000;
-				
-				// prevent over refilling
-				if (m_tank.m_fuel > 3000)
-				{
-					m_tank.m_fuel = 3000;
-				}
-				m_cargoMode.m_fuelPickedUp = true;
-			}
-		}
-		
-		for (int i = 0; i < m_level.m_targets.size(); i++)
-		{
-			TargetData& target = m_level.m_targets[i];
+	m_replay->record(m_world, m_input);
+	m_world.step(dt, m_input);
 
-			if (target.m_active)
-			{
-				remainingTargetTime(i);
+	playEventSounds();
 
-				if (target.m_shot)
-				{
-					targetShot(i);
-				}
-			}
+	switch (m_world.m_gameState)
+	{
+	case GameState::GAME_RUNNING:
 
-			//target can only pop up when previous target time has expired
-			if (m_targetTimer.isExpired())
-			{
-				if (target.m_active == false && target.m_removedFromGame == false)
-				{
-					// current target is not active, deactivate last one and activate current one
-					genNextTarget(i);
-
-				}
-				//removes last final target if player manages to break them all before time runs out
-				else if (target.m_active == true && i == m_level.m_targets.size() - 1)
-				{
-					target.m_active = false;
-					target.m_removedFromGame = true;
-				}
-			}
-		}
+		tankMovingSoundControl();
 
-		updateGameTimer();
+		if (m_world.m_targetVanishing)
+		{
+			TargetData const& target = m_world.m_level.m_targets[m_world.m_vanishingTarget];
+			m_targetTimerText.setPosition(target.m_position + sf::Vector2f{ -5,20 });
+			m_targetTimerText.setString(std::to_string(m_world.m_remainingTime));
+		}
 
 		break;
 
@@ -448,7 +359,7 @@ void Game::update(double dt)
 
 		if (m_readAndWrite == false)
 		{
-			if (m_playerScore >= m_highestPlayerScore)
+			if (m_world.m_playerScore >= m_highestPlayerScore)
 			{
 				writeText();
 				readTextFile();
@@ -474,43 +385,26 @@ void Game::update(double dt)
 }
 
 ////////////////////////////////////////////////////////////
-void Game::render()
+void Game::render(float alpha)
 {
 	m_window.clear(sf::Color(0, 0, 0, 0));
 
-	m_window.draw(m_bgSprite);
-
-	switch (m_gameState)
+	switch (m_world.m_gameState)
 	{
 	case GameState::GAME_RUNNING:
 
-		renderTargets();
-
-		m_tank.render(m_window);
-
-		m_aiTank.render(m_window);
-
-		m_cargoMode.render(m_window);
-
-		// draws the wall obstacles
-		for (sf::Sprite sprite : m_wallSprites)
-		{
-			m_window.draw(sprite);
-		}
-
-		// draws active player bullets
-		for (int i = 0; i < NUM_PLAYER_BULLETS; i++)
+		m_staticLayer.render(m_window, [this](sf::RenderTarget& t_target)
 		{
-			m_tank.m_bullets[i].render(m_window);
-		}
+			t_target.draw(m_bgSprite);
+			m_world.renderStatic(t_target);
+		});
 
-		// draws active ai bullets
-		for (int i = 0; i < NUM_AI_BULLETS; i++)
-		{
-			m_aiTank.m_AIBullets[i].render(m_window);
-		}
+		m_spriteBatch.begin();
+		m_world.render(m_spriteBatch, alpha);
+		m_spriteBatch.flush(m_window);
+		m_world.renderOverlay(m_window, alpha);
 
-		if (m_targetVanishing)
+		if (m_world.m_targetVanishing)
 		{
 			m_window.draw(m_targetTimerText);
 		}
@@ -519,12 +413,14 @@ void Game::render()
 
 	case GameState::GAME_WIN:
 		
+		m_window.draw(m_bgSprite);
 		m_window.draw(m_gameOverText);
 
 		break;
 
 	case GameState::GAME_LOSE:
 		
+		m_window.draw(m_bgSprite);
 		m_window.draw(m_gameOverText);
 
 		break;
@@ -538,26 +434,3 @@ void Game::render()
 	m_window.display();
 
 }
-
-void Game::renderTargets()
-{
-	// loop through all targets in the game
-	for (int i = 0; i < m_level.m_targets.size(); i++)
-	{
-		// get target data
-		TargetData const& target = m_level.m_targets[i];
-		// get sprite that coresponds to current target data
-		sf::Sprite sprite = m_targetSprites[i];
-
-		// draw target sprite if coresponding target is active
-		if (target.m_active)
-		{
-			m_window.draw(sprite);
-		}
-	}
-}
-
-
-
-
-
@@ -1,81 +1,171 @@
 #include "HUD.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+// shown values start as a number no value will have, so the first update always sets them
+static int const NOTHING_SHOWN = std::numeric_limits<int>::min();
 
 ////////////////////////////////////////////////////////////
 HUD::HUD(sf::Font& hudFont)
 	: m_textFont(hudFont)
+	, m_shownFuel(NOTHING_SHOWN)
+	, m_shownTime(NOTHING_SHOWN)
+	, m_shownScore(NOTHING_SHOWN)
 {
-	m_gameStateText.setFont(hudFont);
-	m_gameStateText.setCharacterSize(30);
-	m_gameStateText.setFillColor(sf::Color::Blue);
-	m_gameStateText.setPosition(sf::Vector2f(1200, 5));
-	m_gameStateText.setString("Game Running");
-	m_gameStateText.setStyle(sf::Text::Bold | sf::Text::Underlined);
-
-	//Setting up our hud properties 
+	setUpText(m_gameStateText, hudFont, sf::Vector2f(1200, 5), "Game Running");
+
+	//Setting up our hud properties
 	m_hudOutline.setSize(sf::Vector2f(1440.0f, 40.0f));
 	m_hudOutline.setFillColor(sf::Color(0, 0, 0, 38));
 	m_hudOutline.setOutlineThickness(-.5f);
 	m_hudOutline.setOutlineColor(sf::Color(0, 0, 0, 100));
 	m_hudOutline.setPosition(0, 0);
 
-	m_fuelText.setFont(hudFont);
-	m_fuelText.setCharacterSize(30);
-	m_fuelText.setFillColor(sf::Color::Blue);
-	m_fuelText.setPosition(sf::Vector2f(5, 5));
-	m_fuelText.setString("");
-	m_fuelText.setStyle(sf::Text::Bold | sf::Text::Underlined);
-
-	m_timerText.setFont(hudFont);
-	m_timerText.setCharacterSize(30);
-	m_timerText.setFillColor(sf::Color::Blue);
-	m_timerText.setPosition(sf::Vector2f(335, 5));
-	m_timerText.setString("");
-	m_timerText.setStyle(sf::Text::Bold | sf::Text::Underlined);
-
-	m_objectiveText.setFont(hudFont);
-	m_objectiveText.setCharacterSize(30);
-	m_objectiveText.setFillColor(sf::Color::Blue);
-	m_objectiveText.setPosition(sf::Vector2f(650, 5));
-	m_objectiveText.setString("");
-	m_objectiveText.setStyle(sf::Text::Bold | sf::Text::Underlined);
-
-	m_scoreText.setFont(hudFont);
-	m_scoreText.setCharacterSize(30);
-	m_scoreText.setFillColor(sf::Color::Blue);
-	m_scoreText.setPosition(sf::Vector2f(1270, 5));
-	m_scoreText.setString("");
-	m_scoreText.setStyle(sf::Text::Bold | sf::Text::Underlined);
+	setUpText(m_fuelLabel, hudFont, sf::Vector2f(5, 5), "Fuel Remaining: ");
+	setUpText(m_timerLabel, hudFont, sf::Vector2f(335, 5), "Time Remaining: ");
+	setUpText(m_objectiveLabel, hudFont, sf::Vector2f(650, 5), "Current Objective: ");
+	setUpText(m_scoreLabel, hudFont, sf::Vector2f(1270, 5), "Score: ");
+
+	// the values are moved after their labels once the font is loaded
+	setUpText(m_fuelText, hudFont, m_fuelLabel.getPosition(), "");
+	setUpText(m_timerText, hudFont, m_timerLabel.getPosition(), "");
+	setUpText(m_objectiveText, hudFont, m_objectiveLabel.getPosition(), "");
+	setUpText(m_scoreText, hudFont, m_scoreLabel.getPosition(), "");
 }
 
 ////////////////////////////////////////////////////////////
-void HUD::update(GameState const& gameState, int t_gameTimeRemaining, int t_fuelRemaining, int t_score, std::string t_objectiveText)
+void HUD::update(GameState const& gameState, int t_gameTimeRemaining, int t_fuelRemaining, int t_score, std::string const& t_objectiveText)
 {
-	switch (gameState)
+	if (gameState != m_shownGameState)
 	{
-	case GameState::GAME_RUNNING:
-		break;
-	case GameState::GAME_WIN:
-		m_gameStateText.setString("You Won");
-		break;
-	case GameState::GAME_LOSE:
-		m_gameStateText.setString("You Lost");
-		break;
-	default:
-		break;
+		m_shownGameState = gameState;
+
+		switch (gameState)
+		{
+		case GameState::GAME_RUNNING:
+			m_gameStateText.setString("Game Running");
+			break;
+		case GameState::GAME_WIN:
+			m_gameStateText.setString("You Won");
+			break;
+		case GameState::GAME_LOSE:
+			m_gameStateText.setString("You Lost");
+			break;
+		default:
+			break;
+		}
 	}
 
-	m_timerText.setString("Time Remaining: " + std::to_string(t_gameTimeRemaining));
-	m_fuelText.setString("Fuel Remaining: " + std::to_string(t_fuelRemaining));
-	m_scoreText.setString("Score: " + std::to_string(t_score));
-	m_objectiveText.setString("Current Objective: " + t_objectiveText);
+	showNumber(m_timerText, m_shownTime, t_gameTimeRemaining);
+	showNumber(m_fuelText, m_shownFuel, t_fuelRemaining);
+	showNumber(m_scoreText, m_shownScore, t_score);
+
+	if (t_objectiveText != m_shownObjective)
+	{
+		m_shownObjective = t_objectiveText;
+		m_objectiveText.setString(t_objectiveText);
+	}
 }
 
 void HUD::render(sf::RenderWindow& window)
 {
-	window.draw(m_hudOutline);
+	if (!m_labelsDrawn)
+	{
+		prerenderLabels();
+	}
+
+	if (m_labelTexture)
+	{
+		// the texture holds colours already multiplied by their alpha, from being drawn onto a
+		// transparent texture, so they are not multiplied again
+		window.draw(m_labelSprite, sf::RenderStates(sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha)));
+	}
+	else
+	{
+		window.draw(m_hudOutline);
+		window.draw(m_timerLabel);
+		window.draw(m_fuelLabel);
+		window.draw(m_scoreLabel);
+		window.draw(m_objectiveLabel);
+	}
+
 	window.draw(m_timerText);
 	window.draw(m_fuelText);
 	window.draw(m_scoreText);
 	window.draw(m_objectiveText);
 	//window.draw(m_gameStateText);
-}
\ No newline at end of file
+}
+
+////////////////////////////////////////////////////////////
+void HUD::setUpText(sf::Text& t_text, sf::Font& t_font, sf::Vector2f t_position, sf::String const& t_string)
+{
+	t_text.setFont(t_font);
+	t_text.setCharacterSize(30);
+	t_text.setFillColor(sf::Color::Blue);
+	t_text.setPosition(t_position);
+	t_text.setString(t_string);
+	t_text.setStyle(sf::Text::Bold | sf::Text::Underlined);
+}
+
+////////////////////////////////////////////////////////////
+void HUD::prerenderLabels()
+{
+	m_labelsDrawn = true;
+
+	// each value starts where the end of its label is, trailing space included
+	auto placeAfter = [](sf::Text const& t_label, sf::Text& t_value)
+	{
+		t_value.setPosition(t_label.findCharacterPos(t_label.getString().getSize()).x, t_label.getPosition().y);
+	};
+	placeAfter(m_fuelLabel, m_fuelText);
+	placeAfter(m_timerLabel, m_timerText);
+	placeAfter(m_objectiveLabel, m_objectiveText);
+	placeAfter(m_scoreLabel, m_scoreText);
+
+	// the texture covers the screen from (0,0) to the far edge of the outline or any label,
+	// as the labels' descenders hang below the outline
+	sf::Vector2f size(0.0f, 0.0f);
+	for (sf::FloatRect const& bounds : { m_hudOutline.getGlobalBounds(), m_timerLabel.getGlobalBounds(),
+		m_fuelLabel.getGlobalBounds(), m_scoreLabel.getGlobalBounds(), m_objectiveLabel.getGlobalBounds() })
+	{
+		size.x = std::max(size.x, bounds.left + bounds.width);
+		size.y = std::max(size.y, bounds.top + bounds.height);
+	}
+
+	m_labelTexture = std::make_unique<sf::RenderTexture>();
+	if (!m_labelTexture->create(static_cast<unsigned>(std::ceil(size.x)), static_cast<unsigned>(std::ceil(size.y))))
+	{
+		// the labels are drawn directly instead
+		m_labelTexture.reset();
+		return;
+	}
+
+	m_labelTexture->clear(sf::Color(0, 0, 0, 0));
+	m_labelTexture->draw(m_hudOutline);
+	m_labelTexture->draw(m_timerLabel);
+	m_labelTexture->draw(m_fuelLabel);
+	m_labelTexture->draw(m_scoreLabel);
+	m_labelTexture->draw(m_objectiveLabel);
+	m_labelTexture->display();
+
+	m_labelSprite.setTexture(m_labelTexture->getTexture(), true);
+	m_labelSprite.setPosition(0.0f, 0.0f);
+}
+
+////////////////////////////////////////////////////////////
+void HUD::showNumber(sf::Text& t_text, int& t_shown, int t_value)
+{
+	if (t_value == t_shown)
+	{
+		return;
+	}
+	t_shown = t_value;
+
+	// formatted on the stack, room for the sign and every digit of an int
+	char digits[std::numeric_limits<int>::digits10 + 3];
+	char* end = std::to_chars(digits, digits + sizeof(digits) - 1, t_value).ptr;
+	*end = '\0';
+	t_text.setString(digits);
+}
@@ -0,0 +1,157 @@
+#include "World.h"
+#include "PlayerBot.h"
+#include "RecordedInput.h"
+#include "InputRecorder.h"
+#include "ReplayRecorder.h"
+#include "ReplayPlayer.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Simulation step used by the headless runner, matches Game's notional update time
+static double const MS_PER_UPDATE = 10.0;
+
+/// <summary>
+/// @brief Entry point for the headless simulation runner.
+///
+/// Runs the world without a window, textures or sounds for the requested number of
+///  ticks (default is one 60 second match) and reports the tick rate.
+/// The player is the scripted bot, or a recorded input file when one is given with -i.
+///  Whatever drives the player can be saved with -r and played back later with -i.
+/// -b records the match as a binary replay; -p plays one back (with its own seed),
+///  optionally seeking to tick -g first. A replay always starts from tick 0, so -b can not
+///  be combined with -g.
+/// Usage: tank_headless [-t ticks] [-s seed] [-i input.txt] [-r record.txt]
+///                      [-b replay.tkr] [-p replay.tkr [-g tick]]
+/// </summary>
+int main(int argc, char* argv[])
+{
+	long ticks = 6000;
+	std::uint64_t seed = 1;
+	std::string inputFile;
+	std::string recordFile;
+	std::string replayOutFile;
+	std::string replayInFile;
+	std::uint64_t seekTick = 0;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (std::strcmp(argv[i], "-t") == 0)
+		{
+			ticks = std::atol(argv[i + 1]);
+		}
+		else if (std::strcmp(argv[i], "-s") == 0)
+		{
+			seed = std::strtoull(argv[i + 1], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "-i") == 0)
+		{
+			inputFile = argv[i + 1];
+		}
+		else if (std::strcmp(argv[i], "-r") == 0)
+		{
+			recordFile = argv[i + 1];
+		}
+		else if (std::strcmp(argv[i], "-b") == 0)
+		{
+			replayOutFile = argv[i + 1];
+		}
+		else if (std::strcmp(argv[i], "-p") == 0)
+		{
+			replayInFile = argv[i + 1];
+		}
+		else if (std::strcmp(argv[i], "-g") == 0)
+		{
+			seekTick = std::strtoull(argv[i + 1], nullptr, 10);
+		}
+	}
+
+	// a replay starts from the level and seed, it can not start partway through a match
+	if (!replayOutFile.empty() && seekTick > 0)
+	{
+		std::cout << "-b can not be used with -g, a replay must start from tick 0" << std::endl;
+		return 1;
+	}
+
+	// never loaded, the sprites only need texture rects for collision
+	sf::Texture noTexture;
+
+	try
+	{
+		std::unique_ptr<InputSource> player;
+		ReplayPlayer* replay = nullptr;
+		if (!replayInFile.empty())
+		{
+			replay = new ReplayPlayer(replayInFile);
+			player.reset(replay);
+			seed = replay->seed();
+		}
+		else if (!inputFile.empty())
+		{
+			player.reset(new RecordedInput(inputFile));
+		}
+		else
+		{
+			player.reset(new PlayerBot(PlayerBot::Mode::SCRIPTED));
+		}
+
+		int const level = replay ? replay->level() : 1;
+		World world(noTexture, noTexture, level, seed);
+
+		long tick = 0;
+		if (replay && seekTick > 0)
+		{
+			replay->seek(world, seekTick);
+			tick = static_cast<long>(replay->tick());
+		}
+
+		std::unique_ptr<InputRecorder> recorder;
+		if (!recordFile.empty())
+		{
+			recorder.reset(new InputRecorder(*player, recordFile));
+		}
+		InputSource& input = recorder ? static_cast<InputSource&>(*recorder) : *player;
+
+		std::unique_ptr<ReplayRecorder> replayRecorder;
+		if (!replayOutFile.empty())
+		{
+			replayRecorder.reset(new ReplayRecorder(replayOutFile, level, seed, MS_PER_UPDATE));
+		}
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (; tick < ticks && world.m_gameState == GameState::GAME_RUNNING; tick++)
+		{
+			InputCommand command = input.nextInput(world);
+			if (replayRecorder)
+			{
+				replayRecorder->record(world, command);
+			}
+			world.step(MS_PER_UPDATE, command);
+		}
+		if (replayRecorder)
+		{
+			replayRecorder->finish();
+		}
+
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		std::cout << "Seed: " << seed << "\n";
+		std::cout << "Ticks: " << tick << "\n";
+		std::cout << "Elapsed: " << elapsed.count() << " s\n";
+		std::cout << "Ticks per second: " << (elapsed.count() > 0 ? tick / elapsed.count() : 0) << "\n";
+		std::cout << "Score: " << world.m_playerScore << "\n";
+		std::cout << "Targets hit: " << world.m_targetsHit << "\n";
+		std::cout << "Fuel: " << world.m_tank.m_fuel << "\n";
+	}
+	catch (std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
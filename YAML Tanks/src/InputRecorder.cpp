@@ -0,0 +1,27 @@
+#include "InputRecorder.h"
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////
+InputRecorder::InputRecorder(InputSource& t_source, std::string const& t_fileName)
+	: m_source(t_source)
+	, m_outputFile(t_fileName)
+{
+	if (!m_outputFile.is_open())
+	{
+		throw std::runtime_error("Could not open " + t_fileName + " for recording");
+	}
+}
+
+////////////////////////////////////////////////////////////
+InputCommand InputRecorder::nextInput(World const& t_world)
+{
+	InputCommand input = m_source.nextInput(t_world);
+
+	m_outputFile << static_cast<int>(input.m_throttle) << ' '
+		<< static_cast<int>(input.m_steer) << ' '
+		<< static_cast<int>(input.m_turret) << ' '
+		<< input.m_fire << ' '
+		<< input.m_centreTurret << '\n';
+
+	return input;
+}
@@ -0,0 +1,72 @@
+#include "KeyboardInput.h"
+
+////////////////////////////////////////////////////////////
+void KeyboardInput::handleEvent(sf::Event const& t_event)
+{
+	if (sf::Event::KeyPressed == t_event.type)
+	{
+		setKey(t_event.key.code, true);
+	}
+	else if (sf::Event::KeyReleased == t_event.type)
+	{
+		setKey(t_event.key.code, false);
+	}
+	else if (sf::Event::LostFocus == t_event.type)
+	{
+		*this = KeyboardInput();
+	}
+}
+
+////////////////////////////////////////////////////////////
+InputCommand KeyboardInput::nextInput(World const&)
+{
+	InputCommand input;
+	input.m_throttle = InputCommand::axis(m_down, m_up);
+	input.m_steer = InputCommand::axis(m_left, m_right);
+	input.m_turret = InputCommand::axis(m_turretLeft, m_turretRight);
+	input.m_centreTurret = m_centreTurret;
+	input.m_fire = m_fire;
+	return input;
+}
+
+////////////////////////////////////////////////////////////
+void KeyboardInput::setKey(sf::Keyboard::Key t_key, bool t_down)
+{
+	switch (t_key)
+	{
+	case sf::Keyboard::Up:
+		m_up = t_down;
+		break;
+
+	case sf::Keyboard::Down:
+		m_down = t_down;
+		break;
+
+	case sf::Keyboard::Left:
+		m_left = t_down;
+		break;
+
+	case sf::Keyboard::Right:
+		m_right = t_down;
+		break;
+
+	case sf::Keyboard::Z:
+		m_turretLeft = t_down;
+		break;
+
+	case sf::Keyboard::X:
+		m_turretRight = t_down;
+		break;
+
+	case sf::Keyboard::C:
+		m_centreTurret = t_down;
+		break;
+
+	case sf::Keyboard::Space:
+		m_fire = t_down;
+		break;
+
+	default:
+		break;
+	}
+}
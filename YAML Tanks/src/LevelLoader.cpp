@@ -1,4 +1,5 @@
 #include "LevelLoader.h"
+#include <stdexcept>
 
 // enum for corners of screen, in clockwise order, starting at top left
 // this is used to determine the inital tank spawn
@@ -31,21 +32,12 @@ void operator >> (const YAML::Node& t_obstacleNode, ObstacleData& t_obstacle)
 ////////////////////////////////////////////////////////////
 void operator >> (const YAML::Node& t_targetNode, TargetData& t_target)
 {
-	// extract the max offSet value of the target
-	int maxOffSet = t_targetNode["position"]["maxOffSet"].as<float>();
-
-	// double the offset value
-	int doubleMaxOffSet = maxOffSet *2;
-
-	// generate random number between this new doubled offset, then subtract the original max offset
-	// This allows negative offset values to be generated
-	int randomOffSet = (rand() % doubleMaxOffSet) - maxOffSet;
+	// extract the max offSet value of the target, the offset itself is applied by LevelLoader::load
+	t_target.m_maxOffSet = t_targetNode["position"]["maxOffSet"].as<float>();
 
 	t_target.m_type = t_targetNode["type"].as<std::string>();
-	t_target.m_position.x = t_targetNode["position"]["x"].as<float>() + randomOffSet;
-
-	randomOffSet = (rand() % doubleMaxOffSet) - maxOffSet;
-	t_target.m_position.y = t_targetNode["position"]["y"].as<float>() + randomOffSet;
+	t_target.m_position.x = t_targetNode["position"]["x"].as<float>();
+	t_target.m_position.y = t_targetNode["position"]["y"].as<float>();
 
 	t_target.m_duration = t_targetNode["duration"].as<float>();
 	t_target.m_active = t_targetNode["active"].as<bool>();
@@ -106,7 +98,7 @@ void operator >> (const YAML::Node& t_tankNode, TankData& t_tank)
 /// @brief Top level function that extracts various game data from the YAML data stucture.
 /// 
 /// Invokes other functions to extract the background, tank, target and obstacle data.
-//   Because there are multiple obstacles and targets, obstacle and target data are stored in vectors.
+//   Because there are multiple obstacles, targets and AI tanks, their data are stored in vectors.
 /// </summary>
 /// <param name="t_levelNode">A YAML node</param>
 /// <param name="t_level">A simple struct to store level data for the game</param>
@@ -117,7 +109,24 @@ void operator >> (const YAML::Node& t_levelNode, LevelData& t_level)
 
 	t_levelNode["tank"] >> t_level.m_tank;
 
-	t_levelNode["ai_tank"] >> t_level.m_aiTank;
+	// a level can declare a single "ai_tank", a list of "ai_tanks", or both
+	if (t_levelNode["ai_tank"])
+	{
+		TankData aiTank;
+		t_levelNode["ai_tank"] >> aiTank;
+		t_level.m_aiTanks.push_back(aiTank);
+	}
+
+	if (t_levelNode["ai_tanks"])
+	{
+		const YAML::Node& aiTanksNode = t_levelNode["ai_tanks"].as<YAML::Node>();
+		for (unsigned i = 0; i < aiTanksNode.size(); ++i)
+		{
+			TankData aiTank;
+			aiTanksNode[i] >> aiTank;
+			t_level.m_aiTanks.push_back(aiTank);
+		}
+	}
 
 	const YAML::Node& obstaclesNode = t_levelNode["obstacles"].as<YAML::Node>();
 	for (unsigned i = 0; i < obstaclesNode.size(); ++i)
@@ -137,7 +146,7 @@ void operator >> (const YAML::Node& t_levelNode, LevelData& t_level)
 }
 
 ////////////////////////////////////////////////////////////
-void LevelLoader::load(int t_levelNr, LevelData& t_level)
+void LevelLoader::load(int t_levelNr, LevelData& t_level, Random& t_random)
 {
 	std::string filename = "./resources/levels/level" + std::to_string(t_levelNr) + ".yaml";
 
@@ -147,7 +156,7 @@ void LevelLoader::load(int t_levelNr, LevelData& t_level)
 		if (baseNode.IsNull())
 		{
 			std::string message("File: " + filename + " not found");
-			throw std::exception(message.c_str());
+			throw std::runtime_error(message);
 		}
 		baseNode >> t_level;
 	}
@@ -155,14 +164,19 @@ void LevelLoader::load(int t_levelNr, LevelData& t_level)
 	{
 		std::string message(e.what());
 		message = "YAML Parser Error: " + message;
-		throw std::exception(message.c_str());
+		throw std::runtime_error(message);
 	}
 	catch (std::exception& e)
 	{
 		std::string message(e.what());
 		message = "Unexpected Error: " + message;
-		throw std::exception(message.c_str());
+		throw std::runtime_error(message);
 	}
-}
-
 
+	// offset each target by a random amount in the range -maxOffSet to +maxOffSet
+	for (TargetData& target : t_level.m_targets)
+	{
+		target.m_position.x += t_random.range(-target.m_maxOffSet, target.m_maxOffSet);
+		target.m_position.y += t_random.range(-target.m_maxOffSet, target.m_maxOffSet);
+	}
+}
@@ -0,0 +1,69 @@
+#include "LineOfSight.h"
+#include "MathUtility.h"
+#include <cmath>
+
+////////////////////////////////////////////////////////////
+LineOfSight::LineOfSight(Raycaster const& t_raycaster)
+	: m_raycaster(t_raycaster)
+{
+}
+
+////////////////////////////////////////////////////////////
+void LineOfSight::beginStep()
+{
+	m_stats = Stats();
+}
+
+////////////////////////////////////////////////////////////
+void LineOfSight::canSee(SightQuery const* t_queries, int t_count, sf::Vector2f t_target, bool* t_results)
+{
+	// first pass, the cheap tests for every cone
+	m_candidates.clear();
+	for (int i = 0; i < t_count; i++)
+	{
+		SightQuery const& query = t_queries[i];
+		t_results[i] = false;
+		m_stats.m_queries++;
+
+		sf::Vector2f const offset = t_target - query.m_eye;
+		float const distanceSquared = offset.x * offset.x + offset.y * offset.y;
+		if (distanceSquared > query.m_range * query.m_range)
+		{
+			m_stats.m_rejectedByDistance++;
+			continue;
+		}
+
+		// inside the cone if the angle to the target is at most the half angle, compared as
+		// cosines: dot(facing, offset) >= |offset| * cos(halfAngle)
+		float const along = query.m_facing.x * offset.x + query.m_facing.y * offset.y;
+		float const limit = std::cos(query.m_halfAngle * static_cast<float>(MathUtility::DEG_TO_RAD));
+		if (along < 0.0f || along * along < distanceSquared * limit * limit)
+		{
+			m_stats.m_rejectedByAngle++;
+			continue;
+		}
+
+		m_candidates.push_back(i);
+	}
+
+	// second pass, a ray for each cone that is left
+	for (int i : m_candidates)
+	{
+		m_stats.m_raysCast++;
+		t_results[i] = !m_raycaster.segmentBlocked(t_queries[i].m_eye, t_target);
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool LineOfSight::canSee(SightQuery const& t_query, sf::Vector2f t_target)
+{
+	bool result;
+	canSee(&t_query, 1, t_target, &result);
+	return result;
+}
+
+////////////////////////////////////////////////////////////
+LineOfSight::Stats const& LineOfSight::stats() const
+{
+	return m_stats;
+}
@@ -0,0 +1,95 @@
+#include "MappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////
+MappedFile::MappedFile(std::string const& t_fileName)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(t_fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		throw std::runtime_error("Could not open " + t_fileName);
+	}
+	m_fileHandle = file;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		CloseHandle(file);
+		throw std::runtime_error("Could not map empty file " + t_fileName);
+	}
+	m_size = static_cast<std::size_t>(fileSize.QuadPart);
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (view == nullptr)
+	{
+		if (mapping)
+		{
+			CloseHandle(mapping);
+		}
+		CloseHandle(file);
+		throw std::runtime_error("Could not map " + t_fileName);
+	}
+	m_mappingHandle = mapping;
+	m_data = static_cast<std::uint8_t const*>(view);
+#else
+	int file = open(t_fileName.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		throw std::runtime_error("Could not open " + t_fileName);
+	}
+
+	struct stat fileInfo;
+	if (fstat(file, &fileInfo) != 0 || fileInfo.st_size == 0)
+	{
+		close(file);
+		throw std::runtime_error("Could not map empty file " + t_fileName);
+	}
+	m_size = static_cast<std::size_t>(fileInfo.st_size);
+
+	void* view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+	// the mapping stays valid after the file is closed
+	close(file);
+	if (view == MAP_FAILED)
+	{
+		throw std::runtime_error("Could not map " + t_fileName);
+	}
+	m_data = static_cast<std::uint8_t const*>(view);
+#endif
+}
+
+////////////////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+	UnmapViewOfFile(m_data);
+	CloseHandle(m_mappingHandle);
+	CloseHandle(m_fileHandle);
+#else
+	munmap(const_cast<std::uint8_t*>(m_data), m_size);
+#endif
+}
+
+////////////////////////////////////////////////////////////
+std::uint8_t const* MappedFile::data() const
+{
+	return m_data;
+}
+
+////////////////////////////////////////////////////////////
+std::size_t MappedFile::size() const
+{
+	return m_size;
+}
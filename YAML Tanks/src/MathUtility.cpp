@@ -9,10 +9,21 @@ namespace MathUtility
 	}
 
 	////////////////////////////////////////////////////////////
-	bool lineIntersectsCircle(sf::Vector2f ahead, sf::Vector2f halfAhead, sf::CircleShape circle)
+	float distanceSquared(sf::Vector2f v1, sf::Vector2f v2)
 	{
-		return distance(circle.getPosition(), ahead) <= circle.getRadius() ||
-			distance(circle.getPosition(), halfAhead) <= circle.getRadius();
+		return (v1.x - v2.x) * (v1.x - v2.x) + (v1.y - v2.y) * (v1.y - v2.y);
+	}
+
+	////////////////////////////////////////////////////////////
+	bool lineIntersectsCircle(sf::Vector2f ahead, sf::Vector2f halfAhead, sf::CircleShape const& circle)
+	{
+		return lineIntersectsCircle(ahead, halfAhead, circle.getPosition(), circle.getRadius() * circle.getRadius());
+	}
+
+	////////////////////////////////////////////////////////////
+	bool lineIntersectsCircle(sf::Vector2f ahead, sf::Vector2f halfAhead, sf::Vector2f center, float radiusSq)
+	{
+		return distanceSquared(center, ahead) <= radiusSq || distanceSquared(center, halfAhead) <= radiusSq;
 	}
 
 	////////////////////////////////////////////////////////////
@@ -27,4 +38,17 @@ namespace MathUtility
 		return v;
 	}
 
+	////////////////////////////////////////////////////////////
+	sf::Vector2f lerp(sf::Vector2f from, sf::Vector2f to, float alpha)
+	{
+		return from + (to - from) * alpha;
+	}
+
+	////////////////////////////////////////////////////////////
+	float lerpAngle(float from, float to, float alpha)
+	{
+		float difference = std::fmod(to - from + 540.0f, 360.0f) - 180.0f;
+		return from + difference * alpha;
+	}
+
 }
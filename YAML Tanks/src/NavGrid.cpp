@@ -0,0 +1,155 @@
+#include "NavGrid.h"
+#include "CollisionDetector.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+////////////////////////////////////////////////////////////
+void NavGrid::build(StaticColliders const& t_walls, int t_width, int t_height, float t_cellSize, float t_clearance)
+{
+	m_cellSize = t_cellSize;
+	m_columns = std::max(1, static_cast<int>(std::ceil(t_width / t_cellSize)));
+	m_rows = std::max(1, static_cast<int>(std::ceil(t_height / t_cellSize)));
+	m_walkable.assign(m_columns * m_rows, 1);
+
+	std::vector<int> nearby;
+	for (int row = 0; row < m_rows; row++)
+	{
+		for (int column = 0; column < m_columns; column++)
+		{
+			sf::Vector2f centre = cellCentre(row * m_columns + column);
+			sf::FloatRect area(centre.x - t_clearance, centre.y - t_clearance, t_clearance * 2.0f, t_clearance * 2.0f);
+			OrientedBoundingBox areaBox(area);
+
+			t_walls.query(area, nearby);
+			for (int wall : nearby)
+			{
+				if (CollisionDetector::collision(areaBox, t_walls.box(wall)))
+				{
+					m_walkable[row * m_columns + column] = 0;
+					break;
+				}
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+int NavGrid::cellOf(sf::Vector2f t_position) const
+{
+	int column = static_cast<int>(std::floor(t_position.x / m_cellSize));
+	int row = static_cast<int>(std::floor(t_position.y / m_cellSize));
+	column = std::min(std::max(column, 0), m_columns - 1);
+	row = std::min(std::max(row, 0), m_rows - 1);
+	return row * m_columns + column;
+}
+
+////////////////////////////////////////////////////////////
+sf::Vector2f NavGrid::cellCentre(int t_cell) const
+{
+	int column = t_cell % m_columns;
+	int row = t_cell / m_columns;
+	return sf::Vector2f((column + 0.5f) * m_cellSize, (row + 0.5f) * m_cellSize);
+}
+
+////////////////////////////////////////////////////////////
+bool NavGrid::walkable(int t_cell) const
+{
+	return m_walkable[t_cell] != 0;
+}
+
+////////////////////////////////////////////////////////////
+bool NavGrid::clearLine(int t_from, int t_to) const
+{
+	// Bresenham's line between the two cells, also checking the side cells on diagonal
+	// steps so the line can not slip between two blocked corners
+	int column = t_from % m_columns;
+	int row = t_from / m_columns;
+	int const endColumn = t_to % m_columns;
+	int const endRow = t_to / m_columns;
+	int const deltaColumn = std::abs(endColumn - column);
+	int const deltaRow = -std::abs(endRow - row);
+	int const stepColumn = column < endColumn ? 1 : -1;
+	int const stepRow = row < endRow ? 1 : -1;
+	int error = deltaColumn + deltaRow;
+
+	while (true)
+	{
+		if (!walkable(row * m_columns + column))
+		{
+			return false;
+		}
+		if (column == endColumn && row == endRow)
+		{
+			return true;
+		}
+
+		int const doubled = 2 * error;
+		bool const moveColumn = doubled >= deltaRow;
+		bool const moveRow = doubled <= deltaColumn;
+		if (moveColumn && moveRow &&
+			(!walkable(row * m_columns + column + stepColumn) || !walkable((row + stepRow) * m_columns + column)))
+		{
+			return false;
+		}
+		if (moveColumn)
+		{
+			error += deltaRow;
+			column += stepColumn;
+		}
+		if (moveRow)
+		{
+			error += deltaColumn;
+			row += stepRow;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+int NavGrid::nearestWalkable(int t_cell) const
+{
+	int const column = t_cell % m_columns;
+	int const row = t_cell / m_columns;
+	int const maxRing = std::max(m_columns, m_rows);
+
+	for (int ring = 0; ring < maxRing; ring++)
+	{
+		// the cells on the square ring around the cell, in a fixed order so the answer never varies
+		for (int y = row - ring; y <= row + ring; y++)
+		{
+			for (int x = column - ring; x <= column + ring; x++)
+			{
+				bool const onRing = (y == row - ring || y == row + ring || x == column - ring || x == column + ring);
+				if (onRing && x >= 0 && x < m_columns && y >= 0 && y < m_rows && walkable(y * m_columns + x))
+				{
+					return y * m_columns + x;
+				}
+			}
+		}
+	}
+	return -1;
+}
+
+////////////////////////////////////////////////////////////
+int NavGrid::columns() const
+{
+	return m_columns;
+}
+
+////////////////////////////////////////////////////////////
+int NavGrid::rows() const
+{
+	return m_rows;
+}
+
+////////////////////////////////////////////////////////////
+int NavGrid::size() const
+{
+	return static_cast<int>(m_walkable.size());
+}
+
+////////////////////////////////////////////////////////////
+float NavGrid::cellSize() const
+{
+	return m_cellSize;
+}
@@ -1,9 +1,30 @@
 #include "OrientedBoundingBox.h"
+#include <algorithm>
 
 OrientedBoundingBox::OrientedBoundingBox(const sf::Sprite& Object) // Calculate the four points of the OBB from a transformed (scaled, rotated...) RectangleShape
 {
-	sf::Transform trans = Object.getTransform();
-	sf::IntRect local = Object.getTextureRect();
+	set(Object);
+}
+
+OrientedBoundingBox::OrientedBoundingBox(const sf::FloatRect& Rect)
+{
+	Points[0] = sf::Vector2f(Rect.left, Rect.top);
+	Points[1] = sf::Vector2f(Rect.left + Rect.width, Rect.top);
+	Points[2] = sf::Vector2f(Rect.left + Rect.width, Rect.top + Rect.height);
+	Points[3] = sf::Vector2f(Rect.left, Rect.top + Rect.height);
+
+	Axes[0] = Points[1] - Points[0];
+	Axes[1] = Points[1] - Points[2];
+
+	for (int i = 0; i < 2; i++)
+	{
+		ProjectOntoAxis(Axes[i], AxisMin[i], AxisMax[i]);
+	}
+}
+
+void OrientedBoundingBox::set(const sf::Sprite& Object)
+{
+	sf::Transform const& trans = Object.getTransform();
 
 	float width = Object.getLocalBounds().width;
 	float height = Object.getLocalBounds().height;
@@ -13,9 +34,17 @@ OrientedBoundingBox::OrientedBoundingBox(const sf::Sprite& Object) // Calculate
 	Points[1] = trans.transformPoint(width, 0.f);
 	Points[2] = trans.transformPoint(width, height);
 	Points[3] = trans.transformPoint(0.f, height);
+
+	Axes[0] = Points[1] - Points[0];
+	Axes[1] = Points[1] - Points[2];
+
+	for (int i = 0; i < 2; i++)
+	{
+		ProjectOntoAxis(Axes[i], AxisMin[i], AxisMax[i]);
+	}
 }
 
-void OrientedBoundingBox::ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max) // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
+void OrientedBoundingBox::ProjectOntoAxis(const sf::Vector2f& Axis, float& Min, float& Max) const // Project all four points of the OBB onto the given axis and return the dotproducts of the two outermost points
 {
 	Min = (Points[0].x*Axis.x + Points[0].y*Axis.y);
 	Max = Min;
@@ -28,4 +57,20 @@ void OrientedBoundingBox::ProjectOntoAxis(const sf::Vector2f& Axis, float& Min,
 		if (Projection>Max)
 			Max = Projection;
 	}
-}
\ No newline at end of file
+}
+
+sf::FloatRect OrientedBoundingBox::getBounds() const
+{
+	float left = Points[0].x;
+	float top = Points[0].y;
+	float right = left;
+	float bottom = top;
+	for (int j = 1; j < 4; j++)
+	{
+		left = std::min(left, Points[j].x);
+		top = std::min(top, Points[j].y);
+		right = std::max(right, Points[j].x);
+		bottom = std::max(bottom, Points[j].y);
+	}
+	return sf::FloatRect(left, top, right - left, bottom - top);
+}
@@ -0,0 +1,154 @@
+#include "PathFinder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+static float const DIAGONAL_COST = 1.41421356f;
+
+// the cost of the shortest 8 direction move between two cells with nothing in the way
+static float octileDistance(int t_from, int t_to, int t_columns)
+{
+	int const dx = std::abs(t_from % t_columns - t_to % t_columns);
+	int const dy = std::abs(t_from / t_columns - t_to / t_columns);
+	return static_cast<float>(std::max(dx, dy)) + (DIAGONAL_COST - 1.0f) * static_cast<float>(std::min(dx, dy));
+}
+
+////////////////////////////////////////////////////////////
+bool PathFinder::findPath(NavGrid const& t_grid, sf::Vector2f t_start, sf::Vector2f t_goal, std::vector<sf::Vector2f>& t_path)
+{
+	t_path.clear();
+	m_expanded = 0;
+
+	int const start = t_grid.nearestWalkable(t_grid.cellOf(t_start));
+	int const goal = t_grid.nearestWalkable(t_grid.cellOf(t_goal));
+	if (start < 0 || goal < 0)
+	{
+		return false;
+	}
+
+	if (static_cast<int>(m_cost.size()) != t_grid.size())
+	{
+		m_cost.assign(t_grid.size(), 0.0f);
+		m_parent.assign(t_grid.size(), -1);
+		m_seen.assign(t_grid.size(), 0);
+		m_closed.assign(t_grid.size(), 0);
+		m_search = 0;
+	}
+	m_search++;
+
+	int const columns = t_grid.columns();
+	int const rows = t_grid.rows();
+
+	m_open.clear();
+	m_cost[start] = 0.0f;
+	m_parent[start] = -1;
+	m_seen[start] = m_search;
+	m_open.push_back({ octileDistance(start, goal, columns), start });
+
+	bool found = false;
+	while (!m_open.empty())
+	{
+		std::pop_heap(m_open.begin(), m_open.end(), worse);
+		int const cell = m_open.back().m_cell;
+		m_open.pop_back();
+
+		// a cell can be in the heap more than once, only its cheapest entry counts
+		if (m_closed[cell] == m_search)
+		{
+			continue;
+		}
+		m_closed[cell] = m_search;
+		m_expanded++;
+
+		if (cell == goal)
+		{
+			found = true;
+			break;
+		}
+
+		int const column = cell % columns;
+		int const row = cell / columns;
+		for (int dy = -1; dy <= 1; dy++)
+		{
+			for (int dx = -1; dx <= 1; dx++)
+			{
+				int const x = column + dx;
+				int const y = row + dy;
+				if ((dx == 0 && dy == 0) || x < 0 || x >= columns || y < 0 || y >= rows)
+				{
+					continue;
+				}
+
+				int const next = y * columns + x;
+				if (!t_grid.walkable(next) || m_closed[next] == m_search)
+				{
+					continue;
+				}
+
+				bool const diagonal = (dx != 0 && dy != 0);
+				if (diagonal && (!t_grid.walkable(row * columns + x) || !t_grid.walkable(y * columns + column)))
+				{
+					continue; // would cut the corner of a blocked cell
+				}
+
+				float const cost = m_cost[cell] + (diagonal ? DIAGONAL_COST : 1.0f);
+				if (m_seen[next] != m_search || cost < m_cost[next])
+				{
+					m_seen[next] = m_search;
+					m_cost[next] = cost;
+					m_parent[next] = cell;
+					m_open.push_back({ cost + octileDistance(next, goal, columns), next });
+					std::push_heap(m_open.begin(), m_open.end(), worse);
+				}
+			}
+		}
+	}
+
+	if (!found)
+	{
+		return false;
+	}
+
+	m_cells.clear();
+	for (int cell = goal; cell != -1; cell = m_parent[cell])
+	{
+		m_cells.push_back(cell);
+	}
+	std::reverse(m_cells.begin(), m_cells.end());
+
+	// string pulling: from each kept cell, carry on along the path for as long as the cells
+	// can still be reached in a straight line, and keep the last one that could
+	std::size_t current = 0;
+	while (current + 1 < m_cells.size())
+	{
+		std::size_t furthest = current + 1;
+		while (furthest + 1 < m_cells.size() && t_grid.clearLine(m_cells[current], m_cells[furthest + 1]))
+		{
+			furthest++;
+		}
+		t_path.push_back(t_grid.cellCentre(m_cells[furthest]));
+		current = furthest;
+	}
+	if (t_path.empty())
+	{
+		t_path.push_back(t_grid.cellCentre(goal));
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+int PathFinder::expanded() const
+{
+	return m_expanded;
+}
+
+////////////////////////////////////////////////////////////
+bool PathFinder::worse(OpenNode const& t_a, OpenNode const& t_b)
+{
+	if (t_a.m_estimate != t_b.m_estimate)
+	{
+		return t_a.m_estimate > t_b.m_estimate;
+	}
+	return t_a.m_cell > t_b.m_cell;
+}
@@ -0,0 +1,226 @@
+#include "PathQueue.h"
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////
+PathQueue::PathQueue(NavGrid const& t_grid)
+	: m_grid(t_grid)
+	, m_finders(MAX_SEARCHES_PER_STEP)
+{
+}
+
+////////////////////////////////////////////////////////////
+PathQueue::~PathQueue()
+{
+	try
+	{
+		finishSearches();
+	}
+	catch (...)
+	{
+		// a failed search has nowhere to go once the world is gone
+	}
+}
+
+////////////////////////////////////////////////////////////
+void PathQueue::setThreadPool(ThreadPool* t_pool)
+{
+	finishSearches();
+	m_pool = t_pool;
+}
+
+////////////////////////////////////////////////////////////
+int PathQueue::addRequester()
+{
+	m_requesters.emplace_back();
+	return static_cast<int>(m_requesters.size()) - 1;
+}
+
+////////////////////////////////////////////////////////////
+void PathQueue::request(int t_requester, sf::Vector2f t_start, sf::Vector2f t_goal)
+{
+	m_stats.m_requested++;
+	unsigned const serial = ++m_requesters[t_requester].m_latest;
+
+	// a tank only ever wants its latest path, so an unsearched request is updated in place
+	for (Request& waiting : m_waiting)
+	{
+		if (waiting.m_requester == t_requester)
+		{
+			waiting = Request{ t_requester, serial, t_start, t_goal };
+			m_stats.m_coalesced++;
+			return;
+		}
+	}
+	m_waiting.push_back(Request{ t_requester, serial, t_start, t_goal });
+}
+
+////////////////////////////////////////////////////////////
+bool PathQueue::takeResult(int t_requester, std::vector<sf::Vector2f>& t_path)
+{
+	Requester& requester = m_requesters[t_requester];
+	if (!requester.m_ready)
+	{
+		return false;
+	}
+	t_path.swap(requester.m_result);
+	requester.m_ready = false;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void PathQueue::update()
+{
+	// results nobody picked up last step are out of date
+	for (Requester& requester : m_requesters)
+	{
+		requester.m_ready = false;
+	}
+
+	finishSearches();
+	for (Search& search : m_running)
+	{
+		Requester& requester = m_requesters[search.m_request.m_requester];
+		if (search.m_request.m_serial == requester.m_latest)
+		{
+			requester.m_result.swap(search.m_path);
+			requester.m_ready = true;
+			m_stats.m_delivered++;
+		}
+		else
+		{
+			m_stats.m_dropped++;
+		}
+	}
+	m_running.clear();
+
+	while (!m_waiting.empty() && static_cast<int>(m_running.size()) < MAX_SEARCHES_PER_STEP)
+	{
+		m_running.push_back(Search{ m_waiting.front(), {} });
+		m_waiting.pop_front();
+	}
+	startSearches();
+}
+
+////////////////////////////////////////////////////////////
+void PathQueue::saveState(StateWriter& t_writer) const
+{
+	t_writer.writeVarint(m_requesters.size());
+	for (Requester const& requester : m_requesters)
+	{
+		t_writer.write(requester.m_latest);
+	}
+
+	auto writeRequest = [&t_writer](Request const& t_request)
+	{
+		t_writer.write(t_request.m_requester);
+		t_writer.write(t_request.m_serial);
+		t_writer.writeVector(t_request.m_start);
+		t_writer.writeVector(t_request.m_goal);
+	};
+
+	// running searches are saved as their requests, searching again gives the same paths
+	t_writer.writeVarint(m_running.size());
+	for (Search const& search : m_running)
+	{
+		writeRequest(search.m_request);
+	}
+	t_writer.writeVarint(m_waiting.size());
+	for (Request const& request : m_waiting)
+	{
+		writeRequest(request);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void PathQueue::loadState(StateReader& t_reader)
+{
+	finishSearches();
+
+	if (t_reader.readVarint() != m_requesters.size())
+	{
+		throw std::runtime_error("Path queue snapshot does not match the number of AI tanks");
+	}
+	for (Requester& requester : m_requesters)
+	{
+		t_reader.read(requester.m_latest);
+		requester.m_ready = false;
+		requester.m_result.clear();
+	}
+
+	auto readRequest = [this, &t_reader]()
+	{
+		Request request;
+		t_reader.read(request.m_requester);
+		t_reader.read(request.m_serial);
+		request.m_start = t_reader.readVector();
+		request.m_goal = t_reader.readVector();
+		if (request.m_requester < 0 || request.m_requester >= static_cast<int>(m_requesters.size()))
+		{
+			throw std::runtime_error("Path queue snapshot refers to an unknown AI tank");
+		}
+		return request;
+	};
+
+	std::uint64_t const running = t_reader.readVarint();
+	if (running > static_cast<std::uint64_t>(MAX_SEARCHES_PER_STEP))
+	{
+		throw std::runtime_error("Path queue snapshot has too many running searches");
+	}
+	m_running.clear();
+	for (std::uint64_t i = 0; i < running; i++)
+	{
+		m_running.push_back(Search{ readRequest(), {} });
+	}
+
+	std::uint64_t const waiting = t_reader.readVarint();
+	if (waiting > m_requesters.size())
+	{
+		throw std::runtime_error("Path queue snapshot has too many waiting requests");
+	}
+	m_waiting.clear();
+	for (std::uint64_t i = 0; i < waiting; i++)
+	{
+		m_waiting.push_back(readRequest());
+	}
+
+	startSearches();
+}
+
+////////////////////////////////////////////////////////////
+PathQueue::Stats const& PathQueue::stats() const
+{
+	return m_stats;
+}
+
+////////////////////////////////////////////////////////////
+void PathQueue::startSearches()
+{
+	m_stats.m_searched += static_cast<int>(m_running.size());
+	for (std::size_t i = 0; i < m_running.size(); i++)
+	{
+		Search& search = m_running[i];
+		PathFinder& finder = m_finders[i];
+		auto run = [this, &search, &finder]()
+		{
+			finder.findPath(m_grid, search.m_request.m_start, search.m_request.m_goal, search.m_path);
+		};
+
+		if (m_pool)
+		{
+			m_pool->submit(run);
+		}
+		else
+		{
+			run();
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void PathQueue::finishSearches()
+{
+	if (m_pool)
+	{
+		m_pool->wait();
+	}
+}
@@ -0,0 +1,133 @@
+#include "PlayerBot.h"
+#include "World.h"
+#include "MathUtility.h"
+#include <cmath>
+
+////////////////////////////////////////////////////////////
+PlayerBot::PlayerBot(Mode t_mode)
+	: m_mode(t_mode)
+{
+}
+
+////////////////////////////////////////////////////////////
+InputCommand PlayerBot::nextInput(World const& t_world)
+{
+	InputCommand input;
+
+	switch (m_mode)
+	{
+	case Mode::SCRIPTED:
+		input = scriptedInput();
+		break;
+
+	case Mode::AI:
+		input = aiInput(t_world);
+		break;
+
+	default:
+		break;
+	}
+
+	m_tick++;
+	return input;
+}
+
+////////////////////////////////////////////////////////////
+InputCommand PlayerBot::scriptedInput() const
+{
+	// drive forward, sweep the turret and fire continuously,
+	// turning every few seconds to cover a good part of the level
+	InputCommand input;
+	input.m_throttle = ((m_tick % 400) < 300) ? 1 : 0;
+	input.m_steer = ((m_tick % 400) >= 300) ? 1 : 0;
+	input.m_turret = ((m_tick % 200) < 100) ? -1 : 1;
+	input.m_fire = true;
+	return input;
+}
+
+////////////////////////////////////////////////////////////
+InputCommand PlayerBot::aiInput(World const& t_world)
+{
+	InputCommand input;
+	Tank const& tank = t_world.m_tank;
+	sf::Vector2f position = tank.getPosition();
+
+	// if the tank has barely moved since the last check it is stuck on a wall, so back off for a while
+	if (m_tick % STUCK_CHECK_TICKS == 0)
+	{
+		if (m_tick > 0 && m_reverseTicks == 0 &&
+			MathUtility::distance(position, m_lastCheckPosition) < STUCK_DISTANCE)
+		{
+			m_reverseTicks = REVERSE_TICKS;
+		}
+		m_lastCheckPosition = position;
+	}
+
+	if (m_reverseTicks > 0)
+	{
+		m_reverseTicks--;
+		input.m_throttle = -1;
+		input.m_steer = 1;
+	}
+	else
+	{
+		sf::Vector2f toGoal = currentGoal(t_world) - position;
+		float goalAngle = std::atan2(toGoal.y, toGoal.x) / MathUtility::DEG_TO_RAD;
+		float turn = angleDifference(tank.getBase().getRotation(), goalAngle);
+
+		input.m_steer = InputCommand::axis(turn < -1.0f, turn > 1.0f);
+		input.m_throttle = (std::abs(turn) < DRIVE_TOLERANCE) ? 1 : 0;
+	}
+
+	// aim the turret at the active target, if there is one
+	for (int i = 0; i < t_world.m_level.m_targets.size(); i++)
+	{
+		if (t_world.m_level.m_targets[i].m_active)
+		{
+			sf::FloatRect bounds = t_world.m_targetSprites[i].getGlobalBounds();
+			sf::Vector2f toTarget = sf::Vector2f(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f)
+				- tank.getTurret().getPosition();
+			float targetAngle = std::atan2(toTarget.y, toTarget.x) / MathUtility::DEG_TO_RAD;
+			float aim = angleDifference(tank.getTurret().getRotation(), targetAngle);
+
+			input.m_turret = InputCommand::axis(aim < -1.0f, aim > 1.0f);
+			input.m_fire = std::abs(aim) < AIM_TOLERANCE &&
+				std::sqrt(toTarget.x * toTarget.x + toTarget.y * toTarget.y) < FIRING_RANGE;
+			return input;
+		}
+	}
+
+	input.m_centreTurret = true;
+	return input;
+}
+
+////////////////////////////////////////////////////////////
+sf::Vector2f PlayerBot::currentGoal(World const& t_world) const
+{
+	cargoMode const& cargo = t_world.m_cargoMode;
+
+	if (!cargo.m_fuelPickedUp && t_world.m_tank.m_fuel < LOW_FUEL)
+	{
+		return cargo.getFuelPickUpCentre();
+	}
+	if (!cargo.m_cargoCollected)
+	{
+		return cargo.getCargoCentre();
+	}
+	return cargo.getGoalCentre();
+}
+
+////////////////////////////////////////////////////////////
+float PlayerBot::angleDifference(float t_from, float t_to)
+{
+	float difference = std::fmod(t_to - t_from, 360.0f);
+	if (difference > 180.0f)
+	{
+		difference -= 360.0f;
+	}
+	else if (difference < -180.0f)
+	{
+		difference += 360.0f;
+	}
+	return difference;
+}
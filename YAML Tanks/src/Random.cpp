@@ -0,0 +1,77 @@
+#include "Random.h"
+
+static inline std::uint32_t rotateLeft(std::uint32_t t_value, int t_bits)
+{
+	return (t_value << t_bits) | (t_value >> (32 - t_bits));
+}
+
+////////////////////////////////////////////////////////////
+Random::Random(std::uint64_t t_seed)
+{
+	seed(t_seed);
+}
+
+////////////////////////////////////////////////////////////
+void Random::seed(std::uint64_t t_seed)
+{
+	// splitmix64, as recommended by the xoshiro authors for seeding
+	for (int i = 0; i < 4; i += 2)
+	{
+		t_seed += 0x9E3779B97F4A7C15ULL;
+		std::uint64_t z = t_seed;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		z = z ^ (z >> 31);
+		m_state[i] = static_cast<std::uint32_t>(z);
+		m_state[i + 1] = static_cast<std::uint32_t>(z >> 32);
+	}
+}
+
+////////////////////////////////////////////////////////////
+std::uint32_t Random::next()
+{
+	std::uint32_t const result = rotateLeft(m_state[1] * 5, 7) * 9;
+	std::uint32_t const t = m_state[1] << 9;
+
+	m_state[2] ^= m_state[0];
+	m_state[3] ^= m_state[1];
+	m_state[1] ^= m_state[2];
+	m_state[0] ^= m_state[3];
+
+	m_state[2] ^= t;
+
+	m_state[3] = rotateLeft(m_state[3], 11);
+
+	return result;
+}
+
+////////////////////////////////////////////////////////////
+std::uint32_t Random::below(std::uint32_t t_bound)
+{
+	// Lemire's multiply and shift, rejecting the few values that would bias the result
+	std::uint64_t product = static_cast<std::uint64_t>(next()) * t_bound;
+	std::uint32_t low = static_cast<std::uint32_t>(product);
+	if (low < t_bound)
+	{
+		std::uint32_t threshold = (0u - t_bound) % t_bound;
+		while (low < threshold)
+		{
+			product = static_cast<std::uint64_t>(next()) * t_bound;
+			low = static_cast<std::uint32_t>(product);
+		}
+	}
+	return static_cast<std::uint32_t>(product >> 32);
+}
+
+////////////////////////////////////////////////////////////
+int Random::range(int t_min, int t_max)
+{
+	return t_min + static_cast<int>(below(static_cast<std::uint32_t>(t_max - t_min) + 1));
+}
+
+////////////////////////////////////////////////////////////
+float Random::unit()
+{
+	// top 24 bits, the most a float can hold exactly
+	return (next() >> 8) * (1.0f / 16777216.0f);
+}
@@ -0,0 +1,166 @@
+#include "Raycaster.h"
+#include <algorithm>
+#include <cmath>
+
+////////////////////////////////////////////////////////////
+Raycaster::Raycaster(StaticColliders const& t_walls, std::vector<OrientedBoundingBox> const& t_targetBoxes,
+	std::vector<TargetData> const& t_targets)
+	: m_walls(t_walls)
+	, m_targetBoxes(t_targetBoxes)
+	, m_targets(t_targets)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Raycaster::setTankBox(int t_slot, OrientedBoundingBox const& t_box)
+{
+	if (t_slot >= static_cast<int>(m_tankBoxes.size()))
+	{
+		m_tankBoxes.resize(t_slot + 1);
+	}
+	m_tankBoxes[t_slot] = t_box;
+}
+
+////////////////////////////////////////////////////////////
+bool Raycaster::raycast(sf::Vector2f t_origin, sf::Vector2f t_direction, float t_maxDistance, unsigned t_layerMask, RaycastHit& t_hit) const
+{
+	float const length = std::sqrt(t_direction.x * t_direction.x + t_direction.y * t_direction.y);
+	if (length == 0.0f || t_maxDistance <= 0.0f)
+	{
+		return false;
+	}
+	sf::Vector2f const direction = t_direction / length;
+
+	bool found = false;
+	RaycastHit nearest;
+
+	if (t_layerMask & LAYER_WALL)
+	{
+		sf::Vector2f const end = t_origin + direction * t_maxDistance;
+		m_walls.grid().traverse(t_origin, end, [&](int const* t_first, int const* t_last, float t_exitFraction)
+		{
+			// a wall in several cells is tested once per cell, which is cheaper than remembering
+			// which walls were tested and keeps queries free of shared state
+			for (int const* wall = t_first; wall != t_last; ++wall)
+			{
+				keepNearest(t_origin, direction, t_maxDistance, m_walls.box(*wall), LAYER_WALL, *wall, found, nearest);
+			}
+
+			// nothing in a later cell can be nearer than a hit before the end of this one
+			return found && nearest.m_distance <= t_exitFraction * t_maxDistance;
+		});
+	}
+
+	if (t_layerMask & LAYER_TARGET)
+	{
+		for (int i = 0; i < static_cast<int>(m_targets.size()); i++)
+		{
+			if (m_targets[i].m_active && !m_targets[i].m_shot)
+			{
+				keepNearest(t_origin, direction, t_maxDistance, m_targetBoxes[i], LAYER_TARGET, i, found, nearest);
+			}
+		}
+	}
+
+	if (t_layerMask & LAYER_TANK)
+	{
+		for (int slot = 0; slot < static_cast<int>(m_tankBoxes.size()); slot++)
+		{
+			keepNearest(t_origin, direction, t_maxDistance, m_tankBoxes[slot], LAYER_TANK, slot, found, nearest);
+		}
+	}
+
+	if (found)
+	{
+		t_hit = nearest;
+	}
+	return found;
+}
+
+////////////////////////////////////////////////////////////
+bool Raycaster::segmentBlocked(sf::Vector2f t_from, sf::Vector2f t_to, unsigned t_layerMask) const
+{
+	sf::Vector2f const delta = t_to - t_from;
+	float const length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+	RaycastHit hit;
+	return raycast(t_from, delta, length, t_layerMask, hit);
+}
+
+////////////////////////////////////////////////////////////
+bool Raycaster::intersect(sf::Vector2f t_origin, sf::Vector2f t_direction, float t_maxDistance,
+	OrientedBoundingBox const& t_box, float& t_distance, sf::Vector2f& t_normal)
+{
+	// the box is the parallelogram Points[0] + u * edge0 + v * edge1 with u and v in 0..1
+	sf::Vector2f const edges[2] = { t_box.Points[1] - t_box.Points[0], t_box.Points[3] - t_box.Points[0] };
+	sf::Vector2f const relative = t_origin - t_box.Points[0];
+
+	float enter = 0.0f;
+	float leave = t_maxDistance;
+	sf::Vector2f normal = -t_direction;
+
+	for (int i = 0; i < 2; i++)
+	{
+		float const lengthSquared = edges[i].x * edges[i].x + edges[i].y * edges[i].y;
+		if (lengthSquared == 0.0f)
+		{
+			return false; // an empty box, e.g. a tank that has not been placed yet
+		}
+
+		// position and speed of the ray along this edge, in box widths
+		float const position = (relative.x * edges[i].x + relative.y * edges[i].y) / lengthSquared;
+		float const speed = (t_direction.x * edges[i].x + t_direction.y * edges[i].y) / lengthSquared;
+
+		if (speed == 0.0f)
+		{
+			// parallel to this pair of faces, so it has to start between them
+			if (position < 0.0f || position > 1.0f)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		float first = -position / speed;
+		float last = (1.0f - position) / speed;
+		if (first > last)
+		{
+			std::swap(first, last);
+		}
+
+		if (first > enter)
+		{
+			// enters through the face at u = 0 when moving along the edge, at u = 1 otherwise
+			enter = first;
+			float const length = std::sqrt(lengthSquared);
+			normal = (speed > 0.0f ? -edges[i] : edges[i]) / length;
+		}
+		leave = std::min(leave, last);
+
+		if (enter > leave)
+		{
+			return false;
+		}
+	}
+
+	t_distance = enter;
+	t_normal = normal;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void Raycaster::keepNearest(sf::Vector2f t_origin, sf::Vector2f t_direction, float t_maxDistance, OrientedBoundingBox const& t_box,
+	RaycastLayer t_layer, int t_entity, bool& t_found, RaycastHit& t_hit)
+{
+	float distance;
+	sf::Vector2f normal;
+	float const limit = t_found ? t_hit.m_distance : t_maxDistance;
+	if (intersect(t_origin, t_direction, limit, t_box, distance, normal) && (!t_found || distance < t_hit.m_distance))
+	{
+		t_found = true;
+		t_hit.m_layer = t_layer;
+		t_hit.m_entity = t_entity;
+		t_hit.m_distance = distance;
+		t_hit.m_point = t_origin + t_direction * distance;
+		t_hit.m_normal = normal;
+	}
+}
@@ -0,0 +1,60 @@
+#include "RecordedInput.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////
+RecordedInput::RecordedInput(std::string const& t_fileName)
+{
+	std::ifstream inputFile(t_fileName);
+	if (!inputFile.is_open())
+	{
+		throw std::runtime_error("Could not open recorded input " + t_fileName);
+	}
+
+	std::string line;
+	while (std::getline(inputFile, line))
+	{
+		if (line.empty())
+		{
+			continue;
+		}
+
+		std::istringstream values(line);
+		int throttle, steer, turret, fire, centre;
+		if (!(values >> throttle >> steer >> turret >> fire >> centre))
+		{
+			throw std::runtime_error("Invalid recorded input at tick " + std::to_string(m_commands.size()) + " in " + t_fileName);
+		}
+
+		InputCommand input;
+		input.m_throttle = static_cast<std::int8_t>(throttle);
+		input.m_steer = static_cast<std::int8_t>(steer);
+		input.m_turret = static_cast<std::int8_t>(turret);
+		input.m_fire = fire != 0;
+		input.m_centreTurret = centre != 0;
+		m_commands.push_back(input);
+	}
+}
+
+////////////////////////////////////////////////////////////
+InputCommand RecordedInput::nextInput(World const&)
+{
+	if (finished())
+	{
+		return InputCommand();
+	}
+	return m_commands[m_next++];
+}
+
+////////////////////////////////////////////////////////////
+bool RecordedInput::finished() const
+{
+	return m_next >= m_commands.size();
+}
+
+////////////////////////////////////////////////////////////
+std::size_t RecordedInput::size() const
+{
+	return m_commands.size();
+}
@@ -0,0 +1,159 @@
+#include "ReplayPlayer.h"
+#include "World.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////
+ReplayPlayer::ReplayPlayer(std::string const& t_fileName)
+	: m_file(t_fileName)
+	, m_reader(m_file.data(), m_file.size())
+{
+	char magic[4];
+	m_reader.readBytes(magic, sizeof(magic));
+	if (std::memcmp(magic, ReplayFormat::MAGIC, sizeof(magic)) != 0 ||
+		m_reader.read<std::uint16_t>() != ReplayFormat::VERSION)
+	{
+		throw std::runtime_error(t_fileName + " is not a replay file");
+	}
+	m_level = m_reader.read<std::int32_t>();
+	m_seed = m_reader.read<std::uint64_t>();
+	m_msPerUpdate = m_reader.read<std::uint32_t>() / 1000.0;
+	m_reader.read<std::uint32_t>(); // keyframe interval, only needed when recording
+	std::size_t recordsStart = m_reader.position();
+
+	if (m_file.size() < recordsStart + ReplayFormat::TRAILER_SIZE)
+	{
+		throw std::runtime_error(t_fileName + " was not finished, it has no index");
+	}
+	m_reader.seek(m_file.size() - ReplayFormat::TRAILER_SIZE);
+	m_indexOffset = static_cast<std::size_t>(m_reader.read<std::uint64_t>());
+	m_reader.readBytes(magic, sizeof(magic));
+	if (std::memcmp(magic, ReplayFormat::INDEX_MAGIC, sizeof(magic)) != 0 || m_indexOffset < recordsStart)
+	{
+		throw std::runtime_error(t_fileName + " was not finished, it has no index");
+	}
+
+	m_reader.seek(m_indexOffset);
+	std::uint64_t keyframes = m_reader.readVarint();
+	m_tickCount = m_reader.readVarint();
+	for (std::uint64_t i = 0; i < keyframes; i++)
+	{
+		m_indexTicks.push_back(m_reader.readVarint());
+		m_indexOffsets.push_back(static_cast<std::size_t>(m_reader.readVarint()));
+	}
+
+	m_reader.seek(recordsStart);
+}
+
+////////////////////////////////////////////////////////////
+InputCommand ReplayPlayer::nextInput(World const&)
+{
+	while (m_runRemaining == 0)
+	{
+		if (m_reader.position() >= m_indexOffset)
+		{
+			return InputCommand();
+		}
+
+		std::uint8_t type = m_reader.read<std::uint8_t>();
+		if (type == ReplayFormat::INPUT_RECORD)
+		{
+			m_runRemaining = m_reader.readVarint();
+			m_runCommand = ReplayFormat::unpack(m_reader.read<std::uint8_t>());
+		}
+		else if (type == ReplayFormat::KEYFRAME_RECORD)
+		{
+			// only needed when seeking, skip over it
+			m_reader.readVarint();
+			std::size_t size = static_cast<std::size_t>(m_reader.readVarint());
+			m_reader.seek(m_reader.position() + size);
+		}
+		else
+		{
+			throw std::runtime_error("Corrupt replay record");
+		}
+	}
+
+	m_runRemaining--;
+	m_tick++;
+	return m_runCommand;
+}
+
+////////////////////////////////////////////////////////////
+void ReplayPlayer::seek(World& t_world, std::uint64_t t_tick)
+{
+	if (m_indexTicks.empty())
+	{
+		throw std::runtime_error("Replay has no keyframes to seek to");
+	}
+	t_tick = std::min(t_tick, m_tickCount);
+
+	// the last keyframe at or before the tick, the first is always at tick 0
+	auto keyframe = std::upper_bound(m_indexTicks.begin(), m_indexTicks.end(), t_tick);
+	if (keyframe != m_indexTicks.begin())
+	{
+		--keyframe;
+	}
+	std::size_t i = static_cast<std::size_t>(keyframe - m_indexTicks.begin());
+
+	m_reader.seek(m_indexOffsets[i]);
+	if (m_reader.read<std::uint8_t>() != ReplayFormat::KEYFRAME_RECORD || m_reader.readVarint() != m_indexTicks[i])
+	{
+		throw std::runtime_error("Replay index does not point at a keyframe");
+	}
+	std::size_t size = static_cast<std::size_t>(m_reader.readVarint());
+
+	// the snapshot is read straight from the mapping, so it must not run past the end of the file
+	if (size > m_file.size() - m_reader.position())
+	{
+		throw std::runtime_error("Corrupt replay record");
+	}
+	StateReader snapshot(m_file.data() + m_reader.position(), size);
+	t_world.loadState(snapshot);
+	m_reader.seek(m_reader.position() + size);
+
+	m_tick = m_indexTicks[i];
+	m_runRemaining = 0;
+
+	while (m_tick < t_tick)
+	{
+		t_world.step(m_msPerUpdate, nextInput(t_world));
+	}
+}
+
+////////////////////////////////////////////////////////////
+int ReplayPlayer::level() const
+{
+	return m_level;
+}
+
+////////////////////////////////////////////////////////////
+std::uint64_t ReplayPlayer::seed() const
+{
+	return m_seed;
+}
+
+////////////////////////////////////////////////////////////
+double ReplayPlayer::msPerUpdate() const
+{
+	return m_msPerUpdate;
+}
+
+////////////////////////////////////////////////////////////
+std::uint64_t ReplayPlayer::tickCount() const
+{
+	return m_tickCount;
+}
+
+////////////////////////////////////////////////////////////
+std::uint64_t ReplayPlayer::tick() const
+{
+	return m_tick;
+}
+
+////////////////////////////////////////////////////////////
+bool ReplayPlayer::finished() const
+{
+	return m_tick >= m_tickCount;
+}
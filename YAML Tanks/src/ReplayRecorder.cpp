@@ -0,0 +1,132 @@
+#include "ReplayRecorder.h"
+#include "World.h"
+#include <cmath>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////
+ReplayRecorder::ReplayRecorder(std::string const& t_fileName, int t_levelNr, std::uint64_t t_seed,
+	double t_msPerUpdate, float t_keyframeSeconds)
+	: m_outputFile(t_fileName, std::ios::binary)
+{
+	if (!m_outputFile.is_open())
+	{
+		throw std::runtime_error("Could not open " + t_fileName + " for recording");
+	}
+
+	m_keyframeTicks = static_cast<std::uint32_t>(std::lround(t_keyframeSeconds * 1000.0 / t_msPerUpdate));
+	if (m_keyframeTicks == 0)
+	{
+		m_keyframeTicks = 1;
+	}
+
+	m_scratch.writeBytes(ReplayFormat::MAGIC, sizeof(ReplayFormat::MAGIC));
+	m_scratch.write(ReplayFormat::VERSION);
+	m_scratch.write(static_cast<std::int32_t>(t_levelNr));
+	m_scratch.write(t_seed);
+	m_scratch.write(static_cast<std::uint32_t>(std::lround(t_msPerUpdate * 1000.0)));
+	m_scratch.write(m_keyframeTicks);
+	writeScratch();
+}
+
+////////////////////////////////////////////////////////////
+ReplayRecorder::~ReplayRecorder()
+{
+	try
+	{
+		finish();
+	}
+	catch (std::exception&)
+	{
+		// a destructor must not throw, the replay is left without an index
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ReplayRecorder::record(World const& t_world, InputCommand const& t_input)
+{
+	if (m_finished)
+	{
+		return;
+	}
+
+	if (m_tick % m_keyframeTicks == 0)
+	{
+		flushRun();
+
+		m_indexTicks.push_back(m_tick);
+		m_indexOffsets.push_back(m_offset);
+
+		StateWriter snapshot;
+		t_world.saveState(snapshot);
+
+		m_scratch.write(ReplayFormat::KEYFRAME_RECORD);
+		m_scratch.writeVarint(m_tick);
+		m_scratch.writeVarint(snapshot.buffer().size());
+		m_scratch.writeBytes(snapshot.buffer().data(), snapshot.buffer().size());
+		writeScratch();
+	}
+
+	std::uint8_t command = ReplayFormat::pack(t_input);
+	if (m_runLength > 0 && command != m_runCommand)
+	{
+		flushRun();
+	}
+	m_runCommand = command;
+	m_runLength++;
+	m_tick++;
+}
+
+////////////////////////////////////////////////////////////
+void ReplayRecorder::finish()
+{
+	if (m_finished)
+	{
+		return;
+	}
+	m_finished = true;
+
+	flushRun();
+
+	std::uint64_t indexOffset = m_offset;
+	m_scratch.writeVarint(m_indexOffsets.size());
+	m_scratch.writeVarint(m_tick);
+	for (std::size_t i = 0; i < m_indexOffsets.size(); i++)
+	{
+		m_scratch.writeVarint(m_indexTicks[i]);
+		m_scratch.writeVarint(m_indexOffsets[i]);
+	}
+	m_scratch.write(indexOffset);
+	m_scratch.writeBytes(ReplayFormat::INDEX_MAGIC, sizeof(ReplayFormat::INDEX_MAGIC));
+	writeScratch();
+
+	m_outputFile.close();
+}
+
+////////////////////////////////////////////////////////////
+void ReplayRecorder::flushRun()
+{
+	if (m_runLength == 0)
+	{
+		return;
+	}
+
+	m_scratch.write(ReplayFormat::INPUT_RECORD);
+	m_scratch.writeVarint(m_runLength);
+	m_scratch.write(m_runCommand);
+	writeScratch();
+
+	m_runLength = 0;
+}
+
+////////////////////////////////////////////////////////////
+void ReplayRecorder::writeScratch()
+{
+	std::vector<std::uint8_t> const& bytes = m_scratch.buffer();
+	m_outputFile.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	if (!m_outputFile)
+	{
+		throw std::runtime_error("Error writing replay file");
+	}
+	m_offset += bytes.size();
+	m_scratch.clear();
+}
@@ -0,0 +1,118 @@
+#include "SimClock.h"
+#include <cmath>
+
+////////////////////////////////////////////////////////////
+void SimClock::advance(double dt)
+{
+	m_microseconds += static_cast<sf::Int64>(std::llround(dt * 1000.0));
+}
+
+////////////////////////////////////////////////////////////
+sf::Time SimClock::now() const
+{
+	return sf::microseconds(m_microseconds);
+}
+
+////////////////////////////////////////////////////////////
+void SimClock::saveState(StateWriter& t_writer) const
+{
+	t_writer.write(m_microseconds);
+}
+
+////////////////////////////////////////////////////////////
+void SimClock::loadState(StateReader& t_reader)
+{
+	t_reader.read(m_microseconds);
+}
+
+////////////////////////////////////////////////////////////
+SimTimer::SimTimer(SimClock const& t_clock)
+	: m_clock(&t_clock)
+{
+}
+
+////////////////////////////////////////////////////////////
+void SimTimer::reset(sf::Time t_timeLimit)
+{
+	m_timeLimit = t_timeLimit;
+	m_elapsed = sf::Time::Zero;
+	m_running = false;
+}
+
+////////////////////////////////////////////////////////////
+void SimTimer::restart(sf::Time t_timeLimit)
+{
+	reset(t_timeLimit);
+	start();
+}
+
+////////////////////////////////////////////////////////////
+void SimTimer::start()
+{
+	if (!m_running)
+	{
+		m_startTime = m_clock->now();
+		m_running = true;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void SimTimer::stop()
+{
+	if (m_running)
+	{
+		m_elapsed = elapsedTime();
+		m_running = false;
+	}
+}
+
+////////////////////////////////////////////////////////////
+sf::Time SimTimer::getRemainingTime() const
+{
+	sf::Time remaining = m_timeLimit - elapsedTime();
+	if (remaining < sf::Time::Zero)
+	{
+		remaining = sf::Time::Zero;
+	}
+	return remaining;
+}
+
+////////////////////////////////////////////////////////////
+bool SimTimer::isRunning() const
+{
+	return m_running && !isExpired();
+}
+
+////////////////////////////////////////////////////////////
+bool SimTimer::isExpired() const
+{
+	return getRemainingTime() == sf::Time::Zero;
+}
+
+////////////////////////////////////////////////////////////
+sf::Time SimTimer::elapsedTime() const
+{
+	if (m_running)
+	{
+		return m_elapsed + (m_clock->now() - m_startTime);
+	}
+	return m_elapsed;
+}
+
+////////////////////////////////////////////////////////////
+void SimTimer::saveState(StateWriter& t_writer) const
+{
+	t_writer.writeTime(m_timeLimit);
+	t_writer.writeTime(m_elapsed);
+	t_writer.writeTime(m_startTime);
+	t_writer.write(m_running);
+}
+
+////////////////////////////////////////////////////////////
+void SimTimer::loadState(StateReader& t_reader)
+{
+	m_timeLimit = t_reader.readTime();
+	m_elapsed = t_reader.readTime();
+	m_startTime = t_reader.readTime();
+	t_reader.read(m_running);
+}
@@ -0,0 +1,138 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+////////////////////////////////////////////////////////////
+void SpatialGrid::build(std::vector<sf::Sprite> const& t_sprites, float t_cellSize)
+{
+	std::vector<sf::FloatRect> bounds;
+	bounds.reserve(t_sprites.size());
+	for (sf::Sprite const& sprite : t_sprites)
+	{
+		bounds.push_back(sprite.getGlobalBounds());
+	}
+	build(bounds, t_cellSize);
+}
+
+////////////////////////////////////////////////////////////
+void SpatialGrid::build(std::vector<sf::FloatRect> const& t_bounds, float t_cellSize)
+{
+	m_cellSize = t_cellSize;
+	m_bounds = t_bounds;
+	m_cellStart.clear();
+	m_cellObjects.clear();
+	m_columns = 0;
+	m_rows = 0;
+
+	if (t_bounds.empty())
+	{
+		return;
+	}
+
+	sf::Vector2f low(t_bounds[0].left, t_bounds[0].top);
+	sf::Vector2f high = low;
+	for (sf::FloatRect const& bounds : t_bounds)
+	{
+		low.x = std::min(low.x, bounds.left);
+		low.y = std::min(low.y, bounds.top);
+		high.x = std::max(high.x, bounds.left + bounds.width);
+		high.y = std::max(high.y, bounds.top + bounds.height);
+	}
+
+	m_origin = low;
+	m_columns = std::max(1, static_cast<int>(std::ceil((high.x - low.x) / m_cellSize)));
+	m_rows = std::max(1, static_cast<int>(std::ceil((high.y - low.y) / m_cellSize)));
+
+	// count the objects in each cell, turn the counts into offsets, then fill the cells
+	std::vector<int> counts(m_columns * m_rows, 0);
+	for (sf::FloatRect const& bounds : m_bounds)
+	{
+		for (int row = cellRow(bounds.top); row <= cellRow(bounds.top + bounds.height); row++)
+		{
+			for (int column = cellColumn(bounds.left); column <= cellColumn(bounds.left + bounds.width); column++)
+			{
+				counts[row * m_columns + column]++;
+			}
+		}
+	}
+
+	m_cellStart.resize(counts.size() + 1);
+	m_cellStart[0] = 0;
+	for (std::size_t cell = 0; cell < counts.size(); cell++)
+	{
+		m_cellStart[cell + 1] = m_cellStart[cell] + counts[cell];
+	}
+
+	m_cellObjects.resize(m_cellStart.back());
+	std::vector<int> next(m_cellStart.begin(), m_cellStart.end() - 1);
+	for (int i = 0; i < static_cast<int>(m_bounds.size()); i++)
+	{
+		sf::FloatRect const& bounds = m_bounds[i];
+		for (int row = cellRow(bounds.top); row <= cellRow(bounds.top + bounds.height); row++)
+		{
+			for (int column = cellColumn(bounds.left); column <= cellColumn(bounds.left + bounds.width); column++)
+			{
+				m_cellObjects[next[row * m_columns + column]++] = i;
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void SpatialGrid::query(sf::FloatRect const& t_area, std::vector<int>& t_result) const
+{
+	t_result.clear();
+	if (m_bounds.empty())
+	{
+		return;
+	}
+
+	int const firstColumn = cellColumn(t_area.left);
+	int const lastColumn = cellColumn(t_area.left + t_area.width);
+	int const firstRow = cellRow(t_area.top);
+	int const lastRow = cellRow(t_area.top + t_area.height);
+
+	for (int row = firstRow; row <= lastRow; row++)
+	{
+		for (int column = firstColumn; column <= lastColumn; column++)
+		{
+			int const cell = row * m_columns + column;
+			for (int i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++)
+			{
+				int const object = m_cellObjects[i];
+				sf::FloatRect const& bounds = m_bounds[object];
+
+				// an object in several cells is only reported from the first cell it shares
+				// with the query area, so no duplicate check is needed. Touching boxes count
+				// as overlapping, the narrow phase decides
+				if (column == std::max(firstColumn, cellColumn(bounds.left)) &&
+					row == std::max(firstRow, cellRow(bounds.top)) &&
+					bounds.left <= t_area.left + t_area.width && t_area.left <= bounds.left + bounds.width &&
+					bounds.top <= t_area.top + t_area.height && t_area.top <= bounds.top + bounds.height)
+				{
+					t_result.push_back(object);
+				}
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+int SpatialGrid::size() const
+{
+	return static_cast<int>(m_bounds.size());
+}
+
+////////////////////////////////////////////////////////////
+int SpatialGrid::cellColumn(float t_x) const
+{
+	int column = static_cast<int>(std::floor((t_x - m_origin.x) / m_cellSize));
+	return std::min(std::max(column, 0), m_columns - 1);
+}
+
+////////////////////////////////////////////////////////////
+int SpatialGrid::cellRow(float t_y) const
+{
+	int row = static_cast<int>(std::floor((t_y - m_origin.y) / m_cellSize));
+	return std::min(std::max(row, 0), m_rows - 1);
+}
@@ -0,0 +1,102 @@
+#include "SpriteBatch.h"
+#include <algorithm>
+#include <functional>
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::begin()
+{
+	m_items.clear();
+	m_vertices.clear();
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(sf::Sprite const& t_sprite, DrawLayer t_layer)
+{
+	m_items.push_back(Item{ t_layer, t_sprite.getTexture(), m_vertices.size() });
+	m_vertices.resize(m_vertices.size() + VERTICES_PER_SPRITE);
+	spriteVertices(t_sprite, &m_vertices[m_items.back().m_first]);
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::flush(sf::RenderTarget& t_target)
+{
+	m_stats = Stats();
+	m_stats.m_sprites = static_cast<int>(m_items.size());
+
+	// the layers are kept in order, and within a layer the sprites of each texture are kept
+	// together in the order they were submitted
+	std::stable_sort(m_items.begin(), m_items.end(), [](Item const& t_a, Item const& t_b)
+	{
+		if (t_a.m_layer != t_b.m_layer)
+		{
+			return t_a.m_layer < t_b.m_layer;
+		}
+		return std::less<sf::Texture const*>()(t_a.m_texture, t_b.m_texture);
+	});
+
+	m_sorted.resize(m_vertices.size());
+	for (std::size_t i = 0; i < m_items.size(); i++)
+	{
+		std::copy_n(&m_vertices[m_items[i].m_first], VERTICES_PER_SPRITE, &m_sorted[i * VERTICES_PER_SPRITE]);
+	}
+
+	// draws each run of sprites sharing a texture, even where the run crosses layers
+	std::size_t runStart = 0;
+	while (runStart < m_items.size())
+	{
+		sf::Texture const* texture = m_items[runStart].m_texture;
+		std::size_t runEnd = runStart + 1;
+		while (runEnd < m_items.size() && m_items[runEnd].m_texture == texture)
+		{
+			runEnd++;
+		}
+
+		std::size_t const vertexCount = (runEnd - runStart) * VERTICES_PER_SPRITE;
+		t_target.draw(&m_sorted[runStart * VERTICES_PER_SPRITE], vertexCount, sf::Triangles, sf::RenderStates(texture));
+
+		m_stats.m_drawCalls++;
+		m_stats.m_vertices += static_cast<int>(vertexCount);
+		if (texture != nullptr)
+		{
+			m_stats.m_textureBinds++;
+		}
+
+		runStart = runEnd;
+	}
+}
+
+////////////////////////////////////////////////////////////
+SpriteBatch::Stats const& SpriteBatch::stats() const
+{
+	return m_stats;
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::spriteVertices(sf::Sprite const& t_sprite, sf::Vertex* t_vertices)
+{
+	// the corners of a quad in the order its two triangles use them
+	static int const CORNERS[VERTICES_PER_SPRITE] = { 0, 1, 2, 0, 2, 3 };
+
+	sf::Transform const& transform = t_sprite.getTransform();
+	sf::FloatRect const bounds = t_sprite.getLocalBounds();
+	sf::IntRect const textureRect = t_sprite.getTextureRect();
+
+	sf::Vector2f const positions[4] = {
+		transform.transformPoint(0.0f, 0.0f),
+		transform.transformPoint(bounds.width, 0.0f),
+		transform.transformPoint(bounds.width, bounds.height),
+		transform.transformPoint(0.0f, bounds.height) };
+
+	float const left = static_cast<float>(textureRect.left);
+	float const top = static_cast<float>(textureRect.top);
+	float const right = left + textureRect.width;
+	float const bottom = top + textureRect.height;
+	sf::Vector2f const texCoords[4] = { { left, top }, { right, top }, { right, bottom }, { left, bottom } };
+
+	for (std::size_t corner = 0; corner < VERTICES_PER_SPRITE; corner++)
+	{
+		t_vertices[corner].position = positions[CORNERS[corner]];
+		t_vertices[corner].texCoords = texCoords[CORNERS[corner]];
+		t_vertices[corner].color = t_sprite.getColor();
+	}
+}
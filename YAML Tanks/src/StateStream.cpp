@@ -0,0 +1,152 @@
+#include "StateStream.h"
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////
+void StateWriter::writeVarint(std::uint64_t t_value)
+{
+	while (t_value >= 0x80)
+	{
+		m_buffer.push_back(static_cast<std::uint8_t>(t_value | 0x80));
+		t_value >>= 7;
+	}
+	m_buffer.push_back(static_cast<std::uint8_t>(t_value));
+}
+
+////////////////////////////////////////////////////////////
+void StateWriter::writeBytes(void const* t_data, std::size_t t_size)
+{
+	std::uint8_t const* bytes = static_cast<std::uint8_t const*>(t_data);
+	m_buffer.insert(m_buffer.end(), bytes, bytes + t_size);
+}
+
+////////////////////////////////////////////////////////////
+void StateWriter::writeString(std::string const& t_value)
+{
+	writeVarint(t_value.size());
+	writeBytes(t_value.data(), t_value.size());
+}
+
+////////////////////////////////////////////////////////////
+void StateWriter::writeVector(sf::Vector2f t_value)
+{
+	write(t_value.x);
+	write(t_value.y);
+}
+
+////////////////////////////////////////////////////////////
+void StateWriter::writeTime(sf::Time t_value)
+{
+	write(t_value.asMicroseconds());
+}
+
+////////////////////////////////////////////////////////////
+void StateWriter::writeSprite(sf::Sprite const& t_sprite)
+{
+	writeVector(t_sprite.getPosition());
+	write(t_sprite.getRotation());
+}
+
+////////////////////////////////////////////////////////////
+std::vector<std::uint8_t> const& StateWriter::buffer() const
+{
+	return m_buffer;
+}
+
+////////////////////////////////////////////////////////////
+void StateWriter::clear()
+{
+	m_buffer.clear();
+}
+
+////////////////////////////////////////////////////////////
+StateReader::StateReader(std::uint8_t const* t_data, std::size_t t_size)
+	: m_data(t_data)
+	, m_size(t_size)
+{
+}
+
+////////////////////////////////////////////////////////////
+std::uint64_t StateReader::readVarint()
+{
+	std::uint64_t value = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		std::uint8_t byte = *take(1);
+		value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return value;
+		}
+	}
+	throw std::runtime_error("Invalid varint in state data");
+}
+
+////////////////////////////////////////////////////////////
+void StateReader::readBytes(void* t_data, std::size_t t_size)
+{
+	std::memcpy(t_data, take(t_size), t_size);
+}
+
+////////////////////////////////////////////////////////////
+std::string StateReader::readString()
+{
+	std::size_t size = static_cast<std::size_t>(readVarint());
+	char const* characters = reinterpret_cast<char const*>(take(size));
+	return std::string(characters, size);
+}
+
+////////////////////////////////////////////////////////////
+sf::Vector2f StateReader::readVector()
+{
+	sf::Vector2f value;
+	value.x = read<float>();
+	value.y = read<float>();
+	return value;
+}
+
+////////////////////////////////////////////////////////////
+sf::Time StateReader::readTime()
+{
+	return sf::microseconds(read<sf::Int64>());
+}
+
+////////////////////////////////////////////////////////////
+void StateReader::readSprite(sf::Sprite& t_sprite)
+{
+	t_sprite.setPosition(readVector());
+	t_sprite.setRotation(read<float>());
+}
+
+////////////////////////////////////////////////////////////
+std::size_t StateReader::position() const
+{
+	return m_position;
+}
+
+////////////////////////////////////////////////////////////
+void StateReader::seek(std::size_t t_position)
+{
+	if (t_position > m_size)
+	{
+		throw std::runtime_error("Seek past the end of state data");
+	}
+	m_position = t_position;
+}
+
+////////////////////////////////////////////////////////////
+bool StateReader::atEnd() const
+{
+	return m_position >= m_size;
+}
+
+////////////////////////////////////////////////////////////
+std::uint8_t const* StateReader::take(std::size_t t_size)
+{
+	if (t_size > m_size - m_position)
+	{
+		throw std::runtime_error("Unexpected end of state data");
+	}
+	std::uint8_t const* data = m_data + m_position;
+	m_position += t_size;
+	return data;
+}
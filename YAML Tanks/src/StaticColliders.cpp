@@ -0,0 +1,54 @@
+#include "StaticColliders.h"
+
+////////////////////////////////////////////////////////////
+void StaticColliders::build(std::vector<sf::Sprite> const& t_sprites, float t_cellSize)
+{
+	m_boxes.clear();
+	m_boxes.reserve(t_sprites.size());
+	for (sf::Sprite const& sprite : t_sprites)
+	{
+		m_boxes.emplace_back(sprite);
+	}
+
+	m_grid.build(t_sprites, t_cellSize);
+}
+
+////////////////////////////////////////////////////////////
+void StaticColliders::query(sf::FloatRect const& t_area, std::vector<int>& t_result) const
+{
+	m_grid.query(t_area, t_result);
+}
+
+////////////////////////////////////////////////////////////
+OrientedBoundingBox const& StaticColliders::box(int t_index) const
+{
+	return m_boxes[t_index];
+}
+
+////////////////////////////////////////////////////////////
+SpatialGrid const& StaticColliders::grid() const
+{
+	return m_grid;
+}
+
+////////////////////////////////////////////////////////////
+void StaticColliders::gather(std::vector<int> const& t_indices, BoxBatch& t_batch) const
+{
+	t_batch.clear();
+	for (int index : t_indices)
+	{
+		t_batch.add(m_boxes[index]);
+	}
+}
+
+////////////////////////////////////////////////////////////
+std::vector<OrientedBoundingBox> const& StaticColliders::boxes() const
+{
+	return m_boxes;
+}
+
+////////////////////////////////////////////////////////////
+int StaticColliders::size() const
+{
+	return static_cast<int>(m_boxes.size());
+}
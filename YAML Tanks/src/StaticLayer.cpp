@@ -0,0 +1,79 @@
+#include "StaticLayer.h"
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+void StaticLayer::create(sf::Vector2u t_worldSize)
+{
+	m_tiles.clear();
+	m_uncached = false;
+	m_dirty = true;
+
+	for (unsigned top = 0; top < t_worldSize.y; top += TILE_SIZE)
+	{
+		for (unsigned left = 0; left < t_worldSize.x; left += TILE_SIZE)
+		{
+			unsigned width = std::min(TILE_SIZE, t_worldSize.x - left);
+			unsigned height = std::min(TILE_SIZE, t_worldSize.y - top);
+
+			Tile tile;
+			tile.m_area = sf::FloatRect(static_cast<float>(left), static_cast<float>(top), static_cast<float>(width), static_cast<float>(height));
+			tile.m_texture = std::make_unique<sf::RenderTexture>();
+			if (!tile.m_texture->create(width, height))
+			{
+				// no cache is better than a partial one
+				m_tiles.clear();
+				m_uncached = true;
+				return;
+			}
+
+			// the tile only ever shows its own part of the world
+			tile.m_texture->setView(sf::View(tile.m_area));
+			m_tiles.push_back(std::move(tile));
+		}
+	}
+
+	// the sprites refer to the textures, which stay put once the tiles are all created
+	for (Tile& tile : m_tiles)
+	{
+		tile.m_sprite.setTexture(tile.m_texture->getTexture(), true);
+		tile.m_sprite.setPosition(tile.m_area.left, tile.m_area.top);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void StaticLayer::invalidate()
+{
+	m_dirty = true;
+}
+
+////////////////////////////////////////////////////////////
+void StaticLayer::render(sf::RenderTarget& t_target, std::function<void(sf::RenderTarget&)> const& t_drawContents)
+{
+	if (m_uncached)
+	{
+		t_drawContents(t_target);
+		return;
+	}
+
+	if (m_dirty)
+	{
+		rebuild(t_drawContents);
+	}
+
+	for (Tile const& tile : m_tiles)
+	{
+		t_target.draw(tile.m_sprite);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void StaticLayer::rebuild(std::function<void(sf::RenderTarget&)> const& t_drawContents)
+{
+	for (Tile& tile : m_tiles)
+	{
+		tile.m_texture->clear(sf::Color(0, 0, 0, 0));
+		t_drawContents(*tile.m_texture);
+		tile.m_texture->display();
+	}
+	m_dirty = false;
+}
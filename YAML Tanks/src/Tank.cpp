@@ -1,17 +1,18 @@
 #include "Tank.h"
 #include "MathUtility.h"
+#include <algorithm>
 
-Tank::Tank(sf::Texture const& t_texture, std::vector<sf::Sprite>& t_wallSprites,
-	std::vector<sf::Sprite>& t_targetSprites, std::vector<TargetData>& t_targets)
+Tank::Tank(sf::Texture const& t_texture, StaticColliders const& t_walls,
+	std::vector<OrientedBoundingBox> const& t_targetBoxes, std::vector<TargetData>& t_targets, SimClock const& t_clock)
 	: m_texture(t_texture)
-	, m_wallSprites(t_wallSprites)
-	, m_targetSprites(t_targetSprites)
+	, m_walls(t_walls)
+	, m_targetBoxes(t_targetBoxes)
 	, m_targets(t_targets)
 	, m_bullets()
+	, m_firingTimer(t_clock)
 {
 	// Initialises the tank base and turret sprites.
 	initSprites();
-	initSounds();
 
 	// init each bullet
 	for (int i = 0; i < NUM_PLAYER_BULLETS; i++)
@@ -19,17 +20,15 @@ Tank::Tank(sf::Texture const& t_texture, std::vector<sf::Sprite>& t_wallSprites,
 		m_bullets[i].initBullet(t_texture);
 	}
 
-	m_bullets[0].initSounds();
-
 	m_firingTimer.reset(sf::Time(sf::seconds(FIRING_COOLDOWN)));
 	m_firingTimer.start();
 
 }
 
-void Tank::update(double dt)
+void Tank::update(double dt, InputCommand const& t_input, SimEvents& t_events)
 {
 	// first check for key input
-	handleKeyInput();
+	handleKeyInput(t_input);
 
 	// store previous position in case of collision
 	m_previousPosition = m_tankBase.getPosition();
@@ -53,7 +52,7 @@ void Tank::update(double dt)
 	float newYTurret = m_tankBase.getPosition().y + sin(m_rotationRadians) * m_speed * (dt / 1000);
 	m_turret.setPosition(newXTurret, newYTurret);
 
-	processBullets(dt);
+	processBullets(dt, t_input, t_events);
 
 	//make tank gradually come to a stop without further player input
 	gradualStop();
@@ -64,9 +63,6 @@ void Tank::update(double dt)
 		m_stopped = true;
 	}
 
-	// control if moving sound should play or not
-	soundControl();
-
 	// decrease fuel supply by 1/200 of speed
 	if (m_speed > 0)
 	{
@@ -82,18 +78,101 @@ void Tank::update(double dt)
 		deflect();
 		m_stopped = true;
 	}
+
+	// the deflection may have moved the tank back
+	updateBoxes();
+}
+
+void Tank::render(SpriteBatch& t_batch, float alpha)
+{
+	sf::Sprite base = m_tankBase;
+	base.setPosition(MathUtility::lerp(m_renderBasePosition, m_tankBase.getPosition(), alpha));
+	base.setRotation(MathUtility::lerpAngle(m_renderBaseRotation, m_tankBase.getRotation(), alpha));
+
+	sf::Sprite turret = m_turret;
+	turret.setPosition(MathUtility::lerp(m_renderTurretPosition, m_turret.getPosition(), alpha));
+	turret.setRotation(MathUtility::lerpAngle(m_renderTurretRotation, m_turret.getRotation(), alpha));
+
+	t_batch.draw(base, DrawLayer::TANKS);
+	t_batch.draw(turret, DrawLayer::TANKS);
+}
+
+void Tank::storePreviousState()
+{
+	m_renderBasePosition = m_tankBase.getPosition();
+	m_renderTurretPosition = m_turret.getPosition();
+	m_renderBaseRotation = m_tankBase.getRotation();
+	m_renderTurretRotation = m_turret.getRotation();
+
+	for (int i = 0; i < NUM_PLAYER_BULLETS; i++)
+	{
+		m_bullets[i].storePreviousState();
+	}
+}
+
+void Tank::saveState(StateWriter& t_writer) const
+{
+	t_writer.writeSprite(m_tankBase);
+	t_writer.writeSprite(m_turret);
+	t_writer.write(m_fuel);
+	t_writer.write(m_damaged);
+	t_writer.write(m_bulletsFired);
+	t_writer.write(m_bulletsFiredHighScore);
+	t_writer.write(m_stopped);
+	t_writer.write(m_speed);
+	t_writer.writeVector(m_previousPosition);
+	t_writer.write(m_previousSpeed);
+	t_writer.write(m_baseRotation);
+	t_writer.write(m_turretRotation);
+	t_writer.write(m_previousBaseRotation);
+	t_writer.write(m_previousTurretRotation);
+	t_writer.writeVector(m_previousTurretPosition);
+	t_writer.write(m_enableRotation);
+	m_firingTimer.saveState(t_writer);
+
+	for (Bullet const& bullet : m_bullets)
+	{
+		bullet.saveState(t_writer);
+	}
 }
 
-void Tank::render(sf::RenderWindow & window) 
+void Tank::loadState(StateReader& t_reader)
 {
-	window.draw(m_tankBase);
-	window.draw(m_turret);
+	t_reader.readSprite(m_tankBase);
+	t_reader.readSprite(m_turret);
+	t_reader.read(m_fuel);
+	t_reader.read(m_damaged);
+	t_reader.read(m_bulletsFired);
+	t_reader.read(m_bulletsFiredHighScore);
+	t_reader.read(m_stopped);
+	t_reader.read(m_speed);
+	m_previousPosition = t_reader.readVector();
+	t_reader.read(m_previousSpeed);
+	t_reader.read(m_baseRotation);
+	t_reader.read(m_turretRotation);
+	t_reader.read(m_previousBaseRotation);
+	t_reader.read(m_previousTurretRotation);
+	m_previousTurretPosition = t_reader.readVector();
+	t_reader.read(m_enableRotation);
+	m_firingTimer.loadState(t_reader);
+
+	for (Bullet& bullet : m_bullets)
+	{
+		bullet.loadState(t_reader);
+	}
+
+	m_boxesDirty = true;
+	updateBoxes();
+	storePreviousState();
 }
 
 void Tank::setPosition(sf::Vector2f &position)
 {
 	m_tankBase.setPosition(position);
 	m_turret.setPosition(position);
+	m_boxesDirty = true;
+	updateBoxes();
+	storePreviousState();
 }
 
 ////////////////////////////////////////////////////////////
@@ -144,13 +223,13 @@ void Tank::decreaseRotation()
 	}
 }
 
-void Tank::handleKeyInput()
+void Tank::handleKeyInput(InputCommand const& t_input)
 {
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))
+	if (t_input.m_throttle > 0)
 	{
 		increaseSpeed();
 	}
-	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))
+	else if (t_input.m_throttle < 0)
 	{
 		decreaseSpeed();
 	}
@@ -159,23 +238,23 @@ void Tank::handleKeyInput()
 	// (it is false while processing a collison and re_enabled after it is solved)
 	if (m_enableRotation == true)
 	{
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))
+		if (t_input.m_steer < 0)
 		{
 			decreaseRotation();
 		}
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right))
+		else if (t_input.m_steer > 0)
 		{
 			increaseRotation();
 		}
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::Z))
+		if (t_input.m_turret < 0)
 		{
 			decreaseTurretRotation();
 		}
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::X))
+		else if (t_input.m_turret > 0)
 		{
 			increaseTurretRotation();
 		}
-		if (sf::Keyboard::isKeyPressed(sf::Keyboard::C))
+		if (t_input.m_centreTurret)
 		{
 			centreTurret();
 		}
@@ -214,16 +293,21 @@ void Tank::centreTurret()
 
 bool Tank::checkWallCollision()
 {
-	for (sf::Sprite const& sprite : m_wallSprites)
-	{
-		// Checks if either the tank base or turret has collided with the current wall sprite.
-		if (CollisionDetector::collision(m_turret, sprite) ||
-			CollisionDetector::collision(m_tankBase, sprite))
-		{
-			return true;
-		}
-	}
-	return false;
+	updateBoxes();
+
+	// only the walls overlapping the combined bounds of the base and turret can be hit
+	sf::FloatRect baseBounds = m_baseBox.getBounds();
+	sf::FloatRect turretBounds = m_turretBox.getBounds();
+	float left = std::min(baseBounds.left, turretBounds.left);
+	float top = std::min(baseBounds.top, turretBounds.top);
+	float right = std::max(baseBounds.left + baseBounds.width, turretBounds.left + turretBounds.width);
+	float bottom = std::max(baseBounds.top + baseBounds.height, turretBounds.top + turretBounds.height);
+	m_walls.query(sf::FloatRect(left, top, right - left, bottom - top), m_nearbyWalls);
+	m_walls.gather(m_nearbyWalls, m_nearbyBoxes);
+
+	// Checks if either the tank base or turret has collided with any of the nearby walls.
+	return CollisionDetector::collidesWithAny(m_turretBox, m_nearbyBoxes) ||
+		CollisionDetector::collidesWithAny(m_baseBox, m_nearbyBoxes);
 }
 
 void Tank::deflect()
@@ -268,6 +352,38 @@ sf::Sprite Tank::getTurret() const
 	return m_turret;
 }
 
+OrientedBoundingBox const& Tank::getBaseBox() const
+{
+	return m_baseBox;
+}
+
+OrientedBoundingBox const& Tank::getTurretBox() const
+{
+	return m_turretBox;
+}
+
+void Tank::updateBoxes()
+{
+	if (m_boxesDirty || m_tankBase.getPosition() != m_baseBoxPosition || m_tankBase.getRotation() != m_baseBoxRotation)
+	{
+		m_baseBox.set(m_tankBase);
+		m_baseBoxPosition = m_tankBase.getPosition();
+		m_baseBoxRotation = m_tankBase.getRotation();
+	}
+	if (m_boxesDirty || m_turret.getPosition() != m_turretBoxPosition || m_turret.getRotation() != m_turretBoxRotation)
+	{
+		m_turretBox.set(m_turret);
+		m_turretBoxPosition = m_turret.getPosition();
+		m_turretBoxRotation = m_turret.getRotation();
+	}
+	m_boxesDirty = false;
+}
+
+bool Tank::isStopped() const
+{
+	return m_stopped;
+}
+
 void Tank::initSprites()
 {
 	// Initialise the tank base
@@ -287,28 +403,6 @@ void Tank::initSprites()
 
 }
 
-void Tank::initSounds()
-{
-	if (!m_tankFiringBuffer.loadFromFile("./resources/sounds/TankFiring.wav"))
-	{
-		std::string s("Error loading tank firing sound");
-		throw std::exception(s.c_str());
-	}
-
-	m_tankFiringSound.setBuffer(m_tankFiringBuffer);
-	m_tankFiringSound.setVolume(10.0f);
-
-	if (!m_tankMovingBuffer.loadFromFile("./resources/sounds/TankMoving.wav"))
-	{
-		std::string s("Error loading tank moving sound");
-		throw std::exception(s.c_str());
-	}
-
-	m_tankMovingSound.setBuffer(m_tankMovingBuffer);
-	m_tankMovingSound.setVolume(5.0f);
-	m_tankMovingSound.setLoop(true);
-}
-
 void Tank::adjustRotation()
 {
 	// If tank was rotating...
@@ -351,7 +445,7 @@ void Tank::gradualStop()
 
 }
 
-void Tank::processBullets(double dt)
+void Tank::processBullets(double dt, InputCommand const& t_input, SimEvents& t_events)
 {
 	for (int i = 0; i < NUM_PLAYER_BULLETS; i++)
 	{
@@ -359,12 +453,12 @@ void Tank::processBullets(double dt)
 		if (m_firingTimer.isExpired())
 		{
 			// check if player pressed space
-			m_bullets[i].handleKeyInputs();
+			m_bullets[i].handleKeyInputs(t_input);
 
 			// player pressed space to fire, reset timer and find start point
 			if (m_bullets[i].m_firing)
 			{
-				m_tankFiringSound.play();
+				t_events.m_playerShots++;
 
 				m_firingTimer.reset(sf::Time(sf::seconds(FIRING_COOLDOWN)));
 				m_firingTimer.start();
@@ -379,26 +473,11 @@ void Tank::processBullets(double dt)
 		if (m_bullets[i].m_traveling)
 		{
 			m_bullets[i].update(dt);
-			m_bullets[i].wallCollision(m_wallSprites);
-			m_bullets[i].targetCollision(m_targetSprites, m_targets);
+			m_bullets[i].targetCollision(m_walls, m_targetBoxes, m_targets);
+			if (m_bullets[i].wallCollision(m_walls))
+			{
+				t_events.m_wallHits++;
+			}
 		}
 	}
-}
-
-void Tank::soundControl()
-{
-	// tank moving sound effect
-	// tank is moving, toggle sound
-	if (m_toggleMovingSound && m_stopped == false)
-	{
-		m_tankMovingSound.play();
-		m_toggleMovingSound = false;
-	}
-	// if tank is stopped, pause its sound
-	if (m_stopped)
-	{
-		m_tankMovingSound.pause();
-		m_toggleMovingSound = true;
-	}
-}
-
+}
\ No newline at end of file
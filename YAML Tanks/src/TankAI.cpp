@@ -1,163 +1,541 @@
-#include "TankAi.h"
+#include "TankAI.h"
+#include <algorithm>
+#include <stdexcept>
 
 ////////////////////////////////////////////////////////////
-TankAi::TankAi(sf::Texture const& texture, std::vector<sf::Sprite>& wallSprites)
-	: m_aiBehaviour(AiBehaviour::PATROL)
-	, m_texture(texture)
+TankAi::TankAi(sf::Texture const& texture, std::vector<sf::Sprite>& wallSprites, StaticColliders const& walls,
+	LineOfSight& lineOfSight, NavGrid const& navGrid, PathQueue& paths, FlowField& flowField, SimClock const& clock, Random& random)
+	: m_texture(texture)
 	, m_wallSprites(wallSprites)
-	, m_steering(0, 0)
-	, m_AIBullets()
+	, m_walls(walls)
+	, m_lineOfSight(lineOfSight)
+	, m_navGrid(navGrid)
+	, m_flowField(flowField)
+	, m_paths(paths)
+	, m_random(random)
+	, m_clock(clock)
 {
 	// Initialises the tank base and turret sprites.
 	initSprites();
 
-	// init each bullet
-	for (int i = 0; i < NUM_AI_BULLETS; i++)
+	// Setup the arrow visualisation
+	m_arrowLeft.setStyle(thor::Arrow::Style::Forward);
+	m_arrowLeft.setColor(sf::Color::Red);
+	m_arrowRight.setStyle(thor::Arrow::Style::Forward);
+	m_arrowRight.setColor(sf::Color::Red);
+}
+
+////////////////////////////////////////////////////////////
+void TankAi::setThreadPool(ThreadPool* t_pool)
+{
+	m_pool = t_pool;
+}
+
+////////////////////////////////////////////////////////////
+void TankAi::setDecisionBudget(int t_decisions)
+{
+	m_decisionBudget = std::max(1, t_decisions);
+}
+
+////////////////////////////////////////////////////////////
+void TankAi::update(Tank & playerTank, double dt, SimEvents& t_events)
+{
+	int const tanks = count();
+	sf::Vector2f playerPosition = playerTank.getPosition();
+
+	scheduleDecisions(playerPosition);
+	planRoutes();
+
+	if (m_pool && tanks > STEERING_CHUNK)
 	{
-		m_AIBullets[i].initBullet(texture);
+		// each task only writes its own tanks' entries, so the chunks need no locks
+		for (int first = 0; first < tanks; first += STEERING_CHUNK)
+		{
+			int last = std::min(first + STEERING_CHUNK, tanks);
+			m_pool->submit([this, first, last, playerPosition, dt]()
+			{
+				steer(first, last, playerPosition, dt);
+			});
+		}
+		m_pool->wait();
+	}
+	else
+	{
+		steer(0, tanks, playerPosition, dt);
 	}
 
-	m_AIBullets[0].initSounds();
+	// everything from here on can change the behaviours, fire bullets or raise events, so is
+	// done in tank order
+	updateVisionCones(playerTank);
+
+	for (int i = 0; i < tanks; i++)
+	{
+		processBullets(i, dt, playerTank, t_events);
+	}
+}
 
-	m_firingTimer.reset(sf::Time(sf::seconds(FIRING_COOLDOWN)));
-	m_firingTimer.start();
+////////////////////////////////////////////////////////////
+void TankAi::render(SpriteBatch& t_batch, float alpha)
+{
+	for (int i = 0; i < count(); i++)
+	{
+		sf::Vector2f position = MathUtility::lerp(m_renderPosition[i], m_position[i], alpha);
 
-	m_backToPatrolDelay.reset(sf::Time(sf::seconds(DELAY)));
+		t_batch.draw(placeSprite(m_tankBase, position, MathUtility::lerpAngle(m_renderBaseRotation[i], m_rotation[i], alpha)), DrawLayer::TANKS);
+		t_batch.draw(placeSprite(m_turret, position, MathUtility::lerpAngle(m_renderTurretRotation[i], m_turretRotation[i], alpha)), DrawLayer::TANKS);
+	}
 }
 
 ////////////////////////////////////////////////////////////
-void TankAi::update(Tank & playerTank, double dt)
+void TankAi::renderOverlay(sf::RenderTarget& t_target, float alpha)
 {
-	sf::Vector2f acceleration;
-	sf::Vector2f vectorToPlayer = chase(playerTank.getPosition());
-	sf::Vector2f vectorToPatrolDestination = patrol();
+	for (int i = 0; i < count(); i++)
+	{
+		// the vision cone follows the turret
+		sf::Vector2f position = MathUtility::lerp(m_renderPosition[i], m_position[i], alpha);
+		m_arrowLeft.setPosition(position);
+		m_arrowLeft.setDirection(m_visionConeLeft[i]);
+		m_arrowRight.setPosition(position);
+		m_arrowRight.setDirection(m_visionConeRight[i]);
+		t_target.draw(m_arrowLeft);
+		t_target.draw(m_arrowRight);
+	}
 
-	switch (m_aiBehaviour)
+	// renders the obstacles circles that tank avoids for debuging
+	if (m_showObstacles)
 	{
-	case AiBehaviour::ATTACK_PLAYER:
-		
-		m_steering += thor::unitVector(vectorToPlayer);
-		m_steering += collisionAvoidance();
-		m_steering = MathUtility::truncate(m_steering, MAX_FORCE);
-		acceleration = m_steering / MASS;
-		m_velocity = MathUtility::truncate(m_velocity + acceleration, MAX_SPEED);
+		for (sf::CircleShape const& obstacleCircle : m_obstacleShapes)
+		{
+			t_target.draw(obstacleCircle);
+		}
+	}
+}
 
-		break;
+////////////////////////////////////////////////////////////
+void TankAi::showObstacles(bool t_show)
+{
+	m_showObstacles = t_show;
 
-	case AiBehaviour::PATROL:
+	if (t_show && m_obstacleShapes.empty())
+	{
+		for (ObstacleCircle const& obstacle : m_obstacles)
+		{
+			sf::CircleShape circle(std::sqrt(obstacle.m_radiusSq));
+			circle.setOrigin(circle.getRadius(), circle.getRadius());
+			circle.setPosition(obstacle.m_center);
+			circle.setFillColor(sf::Color::Green);
+			m_obstacleShapes.push_back(circle);
+		}
+	}
+}
 
-		m_steering += thor::unitVector(vectorToPatrolDestination);
-		m_steering += collisionAvoidance();
-		m_steering = MathUtility::truncate(m_steering, MAX_FORCE);
-		acceleration = m_steering / MASS;
-		m_velocity = MathUtility::truncate(m_velocity + acceleration, MAX_SPEED);
-		break;
+////////////////////////////////////////////////////////////
+void TankAi::storePreviousState()
+{
+	m_renderPosition = m_position;
+	m_renderBaseRotation = m_rotation;
+	m_renderTurretRotation = m_turretRotation;
 
-	default:
-		break;
+	for (Bullet& bullet : m_AIBullets)
+	{
+		bullet.storePreviousState();
 	}
+}
 
-	// Now we need to convert our velocity vector into a rotation angle between 0 and 359 degrees.
-	// The m_velocity vector works like this: vector(1,0) is 0 degrees, while vector(0, 1) is 90 degrees.
-	// So for example, 223 degrees would be a clockwise offset from 0 degrees (i.e. along x axis).
-	// Note: we add 180 degrees below to convert the final angle into a range 0 to 359 instead of -PI to +PI
-	auto dest = atan2(-1 * m_velocity.y, -1 * m_velocity.x) / thor::Pi * 180 + 180;
+////////////////////////////////////////////////////////////
+void TankAi::saveState(StateWriter& t_writer) const
+{
+	t_writer.write(m_step);
+	t_writer.writeVarint(count());
+	for (int i = 0; i < count(); i++)
+	{
+		t_writer.write(m_lastDecision[i]);
+		t_writer.writeVector(m_position[i]);
+		t_writer.write(m_rotation[i]);
+		t_writer.write(m_turretRotation[i]);
+		t_writer.writeVector(m_velocity[i]);
+		t_writer.writeVector(m_steering[i]);
+		t_writer.writeVector(m_destination[i]);
+		t_writer.write(m_behaviour[i]);
+		t_writer.write(m_patrolDestinationGenerated[i]);
+		t_writer.write(m_pathGoalCell[i]);
+		t_writer.write(m_pathIndex[i]);
+		t_writer.writeVarint(m_path[i].size());
+		for (sf::Vector2f const& waypoint : m_path[i])
+		{
+			t_writer.writeVector(waypoint);
+		}
+		t_writer.writeVector(m_visionConeLeft[i]);
+		t_writer.writeVector(m_visionConeRight[i]);
+		t_writer.write(m_visionConeSweepAngle[i]);
+		m_firingTimer[i].saveState(t_writer);
+		m_backToPatrolDelay[i].saveState(t_writer);
+	}
 
-	auto currentRotation = m_rotation;
+	for (Bullet const& bullet : m_AIBullets)
+	{
+		bullet.saveState(t_writer);
+	}
+}
 
-	// Find the shortest way to rotate towards the player (clockwise or anti-clockwise)
-	if (std::round(currentRotation - dest) == 0.0)
+////////////////////////////////////////////////////////////
+void TankAi::loadState(StateReader& t_reader)
+{
+	t_reader.read(m_step);
+	if (t_reader.readVarint() != static_cast<std::uint64_t>(count()))
 	{
-		m_steering.x = 0;
-		m_steering.y = 0;
+		throw std::runtime_error("AI tank snapshot does not match the number of AI tanks in the level");
 	}
 
-	else if ((static_cast<int>(std::round(dest - currentRotation + 360))) % 360 < 180)
+	for (int i = 0; i < count(); i++)
 	{
-		// rotate clockwise
-		m_rotation = static_cast<int>((m_rotation) + 1) % 360;
+		t_reader.read(m_lastDecision[i]);
+		m_position[i] = t_reader.readVector();
+		t_reader.read(m_rotation[i]);
+		t_reader.read(m_turretRotation[i]);
+		m_velocity[i] = t_reader.readVector();
+		m_steering[i] = t_reader.readVector();
+		m_destination[i] = t_reader.readVector();
+		t_reader.read(m_behaviour[i]);
+		t_reader.read(m_patrolDestinationGenerated[i]);
+		t_reader.read(m_pathGoalCell[i]);
+		t_reader.read(m_pathIndex[i]);
+		std::uint64_t waypoints = t_reader.readVarint();
+		if (waypoints > static_cast<std::uint64_t>(m_navGrid.size()))
+		{
+			throw std::runtime_error("AI path in the snapshot is longer than the navigation grid");
+		}
+		m_path[i].resize(static_cast<std::size_t>(waypoints));
+		for (sf::Vector2f& waypoint : m_path[i])
+		{
+			waypoint = t_reader.readVector();
+		}
+		m_visionConeLeft[i] = t_reader.readVector();
+		m_visionConeRight[i] = t_reader.readVector();
+		t_reader.read(m_visionConeSweepAngle[i]);
+		m_firingTimer[i].loadState(t_reader);
+		m_backToPatrolDelay[i].loadState(t_reader);
 	}
-	else
+
+	for (Bullet& bullet : m_AIBullets)
 	{
-		// rotate anti-clockwise
-		m_rotation = static_cast<int>((m_rotation) - 1) % 360;
+		bullet.loadState(t_reader);
+	}
+
+	for (int i = 0; i < count(); i++)
+	{
+		updateBoxes(i, true);
+	}
+	storePreviousState();
+}
+
+////////////////////////////////////////////////////////////
+void TankAi::init(std::vector<TankData> const& tanks)
+{
+	for (TankData const& tank : tanks)
+	{
+		m_position.push_back(tank.m_position);
+		m_rotation.push_back(0.0f);
+		m_turretRotation.push_back(0.0f);
+		m_velocity.emplace_back();
+		m_steering.emplace_back(0.0f, 0.0f);
+		m_behaviour.push_back(AiBehaviour::PATROL);
+		m_destination.emplace_back();
+		m_patrolDestinationGenerated.push_back(false);
+		m_visionConeSweepAngle.push_back(0.0f);
+
+		m_baseBox.emplace_back();
+		m_turretBox.emplace_back();
+		m_boxPosition.push_back(tank.m_position);
+		m_baseBoxRotation.push_back(0.0f);
+		m_turretBoxRotation.push_back(0.0f);
+		updateBoxes(static_cast<int>(m_position.size()) - 1, true);
+
+		// the cone starts out as a patrol cone along the x axis
+		m_visionConeLeft.push_back(visionConeLengthPatrol * thor::rotatedVector(m_visionConeDir, -visionConeAnglePatrol));
+		m_visionConeRight.push_back(visionConeLengthPatrol * thor::rotatedVector(m_visionConeDir, visionConeAnglePatrol));
+
+		m_pathRequester.push_back(m_paths.addRequester());
+		m_path.emplace_back();
+		m_pathIndex.push_back(0);
+		m_pathGoalCell.push_back(-1);
+
+		// the first steps are shared out so distant tanks take their turns on different steps
+		m_lastDecision.push_back(static_cast<int>(m_position.size() - 1) % DECISION_INTERVAL + 1 - DECISION_INTERVAL);
+		m_deciding.push_back(true);
+
+		m_firingTimer.emplace_back(m_clock);
+		m_firingTimer.back().reset(sf::Time(sf::seconds(FIRING_COOLDOWN)));
+		m_firingTimer.back().start();
+
+		m_backToPatrolDelay.emplace_back(m_clock);
+		m_backToPatrolDelay.back().reset(sf::Time(sf::seconds(DELAY)));
+
+		// init each bullet
+		for (int i = 0; i < NUM_AI_BULLETS; i++)
+		{
+			m_AIBullets.emplace_back();
+			m_AIBullets.back().initBullet(m_texture);
+		}
 	}
 
-	updateMovement(dt);
-	updateVisionCone(playerTank);
+	m_cones.reserve(tanks.size());
+	m_seen.reset(new bool[tanks.size()]());
+	storePreviousState();
 
-	processBullets(dt, playerTank);
+	std::vector<sf::FloatRect> obstacleBounds;
+	for (sf::Sprite const& wallSprite : m_wallSprites)
+	{
+		float radius = wallSprite.getTextureRect().width * 1.0f;
+		sf::Vector2f center = wallSprite.getPosition();
+		m_obstacles.push_back({ center, radius * radius });
+		obstacleBounds.emplace_back(center.x - radius, center.y - radius, 2.0f * radius, 2.0f * radius);
+	}
+	m_obstacleGrid.build(obstacleBounds, OBSTACLE_GRID_CELL_SIZE);
+}
+
+bool TankAi::collidesWithPlayer(Tank const& playerTank) const
+{
+	// Checks if any AI tank has collided with the player tank.
+	for (int i = 0; i < count(); i++)
+	{
+		if (CollisionDetector::collision(m_turretBox[i], playerTank.getTurretBox()) ||
+			CollisionDetector::collision(m_baseBox[i], playerTank.getBaseBox()))
+		{
+			return true;
+		}
+	}
+	return false;
 }
 
 ////////////////////////////////////////////////////////////
-void TankAi::render(sf::RenderWindow & window)
+int TankAi::count() const
 {
-	window.draw(m_tankBase);
-	window.draw(m_turret);
-	window.draw(m_arrowLeft);
-	window.draw(m_arrowRight);
+	return static_cast<int>(m_position.size());
+}
 
-	// renders the obstacles circles that tank avoids for debuging
-	/*for (sf::CircleShape obstacleCircle : m_obstacles)
+////////////////////////////////////////////////////////////
+TankAi::Stats const& TankAi::stats() const
+{
+	return m_stats;
+}
+
+////////////////////////////////////////////////////////////
+OrientedBoundingBox const& TankAi::getBaseBox(int tank) const
+{
+	return m_baseBox[tank];
+}
+
+////////////////////////////////////////////////////////////
+sf::Sprite TankAi::placeSprite(sf::Sprite const& sprite, sf::Vector2f position, float rotation)
+{
+	sf::Sprite placed = sprite;
+	placed.setPosition(position);
+	placed.setRotation(rotation);
+	return placed;
+}
+
+////////////////////////////////////////////////////////////
+void TankAi::scheduleDecisions(sf::Vector2f playerPosition)
+{
+	m_step++;
+	m_due.clear();
+
+	float const nearSq = NEAR_PLAYER_DISTANCE * NEAR_PLAYER_DISTANCE;
+	for (int i = 0; i < count(); i++)
+	{
+		if (m_behaviour[i] == AiBehaviour::ATTACK_PLAYER || MathUtility::distanceSquared(m_position[i], playerPosition) <= nearSq)
+		{
+			m_deciding[i] = true;
+			m_lastDecision[i] = m_step;
+			m_stats.m_fullUpdates++;
+		}
+		else if (m_step - m_lastDecision[i] >= DECISION_INTERVAL)
+		{
+			m_due.push_back(i);
+		}
+		else
+		{
+			m_deciding[i] = false;
+			m_stats.m_extrapolated++;
+		}
+	}
+
+	// the tanks that have waited longest go first, then the order the tanks were declared in
+	std::sort(m_due.begin(), m_due.end(), [this](int t_a, int t_b)
+	{
+		return (m_lastDecision[t_a] != m_lastDecision[t_b]) ? m_lastDecision[t_a] < m_lastDecision[t_b] : t_a < t_b;
+	});
+
+	for (int i = 0; i < static_cast<int>(m_due.size()); i++)
 	{
-		window.draw(obstacleCircle);
-	}*/
-	
+		int tank = m_due[i];
+		if (i < m_decisionBudget)
+		{
+			m_deciding[tank] = true;
+			m_lastDecision[tank] = m_step;
+			m_stats.m_reducedUpdates++;
+		}
+		else
+		{
+			m_deciding[tank] = false;
+			m_stats.m_deferred++;
+			m_stats.m_extrapolated++;
+		}
+	}
 }
 
 ////////////////////////////////////////////////////////////
-void TankAi::init(sf::Vector2f position)
+void TankAi::planRoutes()
 {
-	m_tankBase.setPosition(position);
-	m_turret.setPosition(position);
+	bool chasing = false;
 
-	setVisionCone();
+	for (int i = 0; i < count(); i++)
+	{
+		if (!m_deciding[i])
+		{
+			continue;
+		}
 
-	for (sf::Sprite const wallSprite : m_wallSprites)
+		switch (m_behaviour[i])
+		{
+		case AiBehaviour::ATTACK_PLAYER:
+			// the patrol path is out of date by the time the chase ends, so plan a new one then
+			m_pathGoalCell[i] = -1;
+			chasing = true;
+			break;
+
+		case AiBehaviour::PATROL:
+			patrol(i);
+			requestPath(i, m_destination[i]);
+			break;
+		}
+	}
+
+	// the flow field is only read while steering
+	if (chasing)
 	{
-		sf::CircleShape circle(wallSprite.getTextureRect().width * 1.0f);
-		circle.setOrigin(circle.getRadius(), circle.getRadius());
-		circle.setPosition(wallSprite.getPosition());
-		circle.setFillColor(sf::Color::Green);
-		m_obstacles.push_back(circle);
+		m_flowField.refresh();
 	}
 }
 
-bool TankAi::collidesWithPlayer(Tank const& playerTank) const
+////////////////////////////////////////////////////////////
+void TankAi::steer(int first, int last, sf::Vector2f playerPosition, double dt)
 {
-	// Checks if the AI tank has collided with the player tank.
-	if (CollisionDetector::collision(m_turret, playerTank.getTurret()) ||
-		CollisionDetector::collision(m_tankBase, playerTank.getBase()))
+	for (int i = first; i < last; i++)
 	{
-		return true;
+		// a tank that is not deciding this step keeps the velocity it last chose
+		if (m_deciding[i])
+		{
+			updateSteering(i, playerPosition);
+		}
+		updateMovement(i, dt);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void TankAi::updateSteering(int tank, sf::Vector2f playerPosition)
+{
+	sf::Vector2f& steering = m_steering[tank];
+
+	switch (m_behaviour[tank])
+	{
+	case AiBehaviour::ATTACK_PLAYER:
+		steering += thor::unitVector(chase(tank, playerPosition));
+		break;
+
+	case AiBehaviour::PATROL:
+		steering += thor::unitVector(followPath(tank, m_destination[tank]));
+		break;
+
+	default:
+		break;
+	}
+
+	steering += collisionAvoidance(tank);
+	steering = MathUtility::truncate(steering, MAX_FORCE);
+	sf::Vector2f acceleration = steering / MASS;
+	m_velocity[tank] = MathUtility::truncate(m_velocity[tank] + acceleration, MAX_SPEED);
+}
+
+////////////////////////////////////////////////////////////
+sf::Vector2f TankAi::chase(int tank, sf::Vector2f playerPosition)
+{
+	sf::Vector2f position = m_position[tank];
+
+	// nothing in the way, drive straight at the player
+	if (m_navGrid.clearLine(m_navGrid.cellOf(position), m_navGrid.cellOf(playerPosition)))
+	{
+		return playerPosition - position;
+	}
+
+	sf::Vector2f heading;
+	if (m_flowField.direction(position, heading) && (heading.x != 0.0f || heading.y != 0.0f))
+	{
+		return heading;
+	}
+	return playerPosition - position;
+}
+
+void TankAi::patrol(int tank)
+{
+	if (!m_patrolDestinationGenerated[tank])
+	{
+		float x = static_cast<float>(m_random.below(ScreenSize::s_width));
+		float y = static_cast<float>(m_random.below(ScreenSize::s_height));
+
+		// a point inside a wall can never be reached, use the nearest open cell instead
+		int cell = m_navGrid.nearestWalkable(m_navGrid.cellOf({ x, y }));
+		m_destination[tank] = (cell >= 0) ? m_navGrid.cellCentre(cell) : sf::Vector2f(x, y);
+		m_patrolDestinationGenerated[tank] = true;
+	}
+
+	// pick a new destination once this one is reached
+	if (MathUtility::distance(m_position[tank], m_destination[tank]) < WAYPOINT_REACHED)
+	{
+		m_patrolDestinationGenerated[tank] = false;
 	}
-	return false;
 }
 
 ////////////////////////////////////////////////////////////
-sf::Vector2f TankAi::chase(sf::Vector2f playerPosition) const
+void TankAi::requestPath(int tank, sf::Vector2f goal)
 {
-	sf::Vector2f answer;
-	answer = (playerPosition - m_tankBase.getPosition());
-	return answer;
+	if (m_paths.takeResult(m_pathRequester[tank], m_path[tank]))
+	{
+		m_pathIndex[tank] = 0;
+	}
+
+	int goalCell = m_navGrid.cellOf(goal);
+	if (goalCell != m_pathGoalCell[tank])
+	{
+		m_pathGoalCell[tank] = goalCell;
+		m_paths.request(m_pathRequester[tank], m_position[tank], goal);
+	}
 }
 
-sf::Vector2f TankAi::patrol()
+////////////////////////////////////////////////////////////
+sf::Vector2f TankAi::followPath(int tank, sf::Vector2f goal)
 {
-	if (m_patrolDestinationGenerated == false)
+	sf::Vector2f position = m_position[tank];
+	std::vector<sf::Vector2f> const& path = m_path[tank];
+	int& pathIndex = m_pathIndex[tank];
+
+	// drive on to the next waypoint once this one is close enough
+	int lastWaypoint = static_cast<int>(path.size()) - 1;
+	while (pathIndex < lastWaypoint && MathUtility::distance(position, path[pathIndex]) < WAYPOINT_REACHED)
 	{
-		float x = rand() % ScreenSize::s_width;
-		float y = rand() % ScreenSize::s_height;
-		m_destination = { x, y };
-		m_patrolDestinationGenerated = true;
+		pathIndex++;
 	}
 
-	sf::Vector2f answer;
-	answer = (m_destination - m_tankBase.getPosition());
-	return answer;
+	// no path, or on the last stretch, head straight for the goal
+	if (path.empty() || pathIndex >= lastWaypoint)
+	{
+		return goal - position;
+	}
+	return path[pathIndex] - position;
 }
 
-float TankAi::distanceBetween(sf::Vector2f playerPos, sf::Vector2f aiPos)
+float TankAi::distanceBetween(sf::Vector2f playerPos, sf::Vector2f aiPos) const
 {
 	float distanceBetween = ((aiPos.x - playerPos.x) * (aiPos.x - playerPos.x)) + ((aiPos.y - playerPos.y) * (aiPos.y - playerPos.y));
 	distanceBetween = std::sqrt(distanceBetween);
@@ -165,34 +543,36 @@ float TankAi::distanceBetween(sf::Vector2f playerPos, sf::Vector2f aiPos)
 }
 
 ////////////////////////////////////////////////////////////
-sf::Vector2f TankAi::collisionAvoidance()
+sf::Vector2f TankAi::collisionAvoidance(int tank) const
 {
-	auto headingRadians = thor::toRadian(m_rotation);
+	auto headingRadians = thor::toRadian(m_rotation[tank]);
 	sf::Vector2f headingVector(std::cos(headingRadians) * MAX_SEE_AHEAD, std::sin(headingRadians) * MAX_SEE_AHEAD);
-	m_ahead = m_tankBase.getPosition() + headingVector;
-	
-	m_halfAhead = m_tankBase.getPosition() + (headingVector * 0.5f);
-	const sf::CircleShape mostThreatening = findMostThreateningObstacle();
+	sf::Vector2f ahead = m_position[tank] + headingVector;
+
+	sf::Vector2f halfAhead = m_position[tank] + (headingVector * 0.5f);
+	int mostThreatening = findMostThreateningObstacle(m_position[tank], ahead, halfAhead);
 	sf::Vector2f avoidance(0, 0);
 
 	// tank is on possibily on course to collide with most threatening obstacle
-	if (mostThreatening.getRadius() != 0.0)
-	{	
+	if (mostThreatening >= 0)
+	{
+		ObstacleCircle const& obstacle = m_obstacles[mostThreatening];
+
 		// check if ahead point is just barely inside or outside the most threathning radius
-		// if true, ignore avoidance
-		if (MathUtility::distance(m_ahead, mostThreatening.getPosition()) >= mostThreatening.getRadius() * 0.9 &&
-			MathUtility::distance(m_ahead, mostThreatening.getPosition()) <= mostThreatening.getRadius() * 1.1)
+		// (0.9 to 1.1 times the radius, squared) if true, ignore avoidance
+		float aheadDistanceSq = MathUtility::distanceSquared(ahead, obstacle.m_center);
+		if (aheadDistanceSq >= obstacle.m_radiusSq * 0.81f && aheadDistanceSq <= obstacle.m_radiusSq * 1.21f)
 		{
 			avoidance *= 0.0f;
 		}
-		else // tank will collide, calculate its path to avoid colliding 
+		else // tank will collide, calculate its path to avoid colliding
 		{
-			avoidance.x = m_ahead.x - mostThreatening.getPosition().x;
-			avoidance.y = m_ahead.y - mostThreatening.getPosition().y;
+			avoidance.x = ahead.x - obstacle.m_center.x;
+			avoidance.y = ahead.y - obstacle.m_center.y;
 			avoidance = thor::unitVector(avoidance);
 			avoidance *= MAX_AVOID_FORCE;
 		}
-		
+
 	}
 	else // not close enough to most threathening to try avoid it
 	{
@@ -202,22 +582,32 @@ sf::Vector2f TankAi::collisionAvoidance()
 }
 
 ////////////////////////////////////////////////////////////
-const sf::CircleShape TankAi::findMostThreateningObstacle()
+int TankAi::findMostThreateningObstacle(sf::Vector2f position, sf::Vector2f ahead, sf::Vector2f halfAhead) const
 {
-	sf::CircleShape mostThreatening;
-	mostThreatening.setRadius(0);
+	int mostThreatening = -1;
+	float nearestSq = 0.0f;
 
-	for (int i = 0; i < m_obstacles.size(); i++)
+	m_obstacleGrid.traverse(halfAhead, ahead, [&](int const* t_first, int const* t_last, float)
 	{
-		sf::CircleShape obstacle = m_obstacles[i];
-		bool collide = (MathUtility::lineIntersectsCircle(m_ahead, m_halfAhead, obstacle));
-
-		if (collide && (mostThreatening.getRadius() != 0 || MathUtility::distance(m_tankBase.getPosition(), obstacle.getPosition()) <
-			MathUtility::distance(m_tankBase.getPosition(), mostThreatening.getPosition())))
+		for (int const* index = t_first; index != t_last; ++index)
 		{
-			mostThreatening = obstacle;
+			ObstacleCircle const& obstacle = m_obstacles[*index];
+			if (!MathUtility::lineIntersectsCircle(ahead, halfAhead, obstacle.m_center, obstacle.m_radiusSq))
+			{
+				continue;
+			}
+
+			// an obstacle in several cells is seen more than once, ties go to the lowest index
+			// so the cells' order does not matter
+			float distanceSq = MathUtility::distanceSquared(position, obstacle.m_center);
+			if (mostThreatening < 0 || distanceSq < nearestSq || (distanceSq == nearestSq && *index < mostThreatening))
+			{
+				mostThreatening = *index;
+				nearestSq = distanceSq;
+			}
 		}
-	}
+		return false;
+	});
 
 	return mostThreatening;
 }
@@ -240,208 +630,243 @@ void TankAi::initSprites()
 	m_turret.setScale(0.5, 0.5);
 }
 
-void TankAi::setVisionCone()
+////////////////////////////////////////////////////////////
+void TankAi::updateMovement(int tank, double dt)
 {
-	m_visionConeLeft = m_turret.getPosition();
-	m_visionConeRight = m_turret.getPosition();
+	float& rotation = m_rotation[tank];
 
-	// Setup the arrow visualisation
-	m_arrowLeft.setStyle(thor::Arrow::Style::Forward);
-	m_arrowLeft.setColor(sf::Color::Red);
-	m_arrowLeft.setPosition(m_visionConeLeft);
-	m_arrowRight.setStyle(thor::Arrow::Style::Forward);
-	m_arrowRight.setColor(sf::Color::Red);
-	m_arrowRight.setPosition(m_visionConeRight);
+	// Now we need to convert our velocity vector into a rotation angle between 0 and 359 degrees.
+	// The m_velocity vector works like this: vector(1,0) is 0 degrees, while vector(0, 1) is 90 degrees.
+	// So for example, 223 degrees would be a clockwise offset from 0 degrees (i.e. along x axis).
+	// Note: we add 180 degrees below to convert the final angle into a range 0 to 359 instead of -PI to +PI
+	auto dest = atan2(-1 * m_velocity[tank].y, -1 * m_velocity[tank].x) / thor::Pi * 180 + 180;
 
-	m_arrowLeft.setDirection(visionConeLengthPatrol * thor::rotatedVector(m_visionConeDir, -visionConeAnglePatrol));
-	m_arrowRight.setDirection(visionConeLengthPatrol * thor::rotatedVector(m_visionConeDir, visionConeAnglePatrol));
-}
+	auto currentRotation = rotation;
 
+	// Find the shortest way to rotate towards the player (clockwise or anti-clockwise)
+	if (std::round(currentRotation - dest) == 0.0)
+	{
+		m_steering[tank].x = 0;
+		m_steering[tank].y = 0;
+	}
 
-////////////////////////////////////////////////////////////
-void TankAi::updateMovement(double dt)
-{
-	double speed = thor::length(m_velocity);
-	sf::Vector2f newPos(m_tankBase.getPosition().x + std::cos(MathUtility::DEG_TO_RAD  * m_rotation) * speed * (dt / 1000),
-		m_tankBase.getPosition().y + std::sin(MathUtility::DEG_TO_RAD  * m_rotation) * speed * (dt / 1000));
-	m_tankBase.setPosition(newPos.x, newPos.y);
-	m_tankBase.setRotation(m_rotation);
-	m_turret.setPosition(m_tankBase.getPosition());
+	else if ((static_cast<int>(std::round(dest - currentRotation + 360))) % 360 < 180)
+	{
+		// rotate clockwise
+		rotation = static_cast<int>((rotation) + 1) % 360;
+	}
+	else
+	{
+		// rotate anti-clockwise
+		rotation = static_cast<int>((rotation) - 1) % 360;
+	}
 
-	switch (m_aiBehaviour)
+	double speed = thor::length(m_velocity[tank]);
+	m_position[tank].x += std::cos(MathUtility::DEG_TO_RAD * rotation) * speed * (dt / 1000);
+	m_position[tank].y += std::sin(MathUtility::DEG_TO_RAD * rotation) * speed * (dt / 1000);
+
+	switch (m_behaviour[tank])
 	{
 	case AiBehaviour::ATTACK_PLAYER:
-
-		m_turret.setRotation(m_rotation);
+		m_turretRotation[tank] = rotation;
 		break;
 
 	case AiBehaviour::PATROL:
-		m_turret.setRotation(m_visionConeSweepAngle);
+		m_turretRotation[tank] = m_visionConeSweepAngle[tank];
 		break;
-	} 
+	}
+
+	updateBoxes(tank, false);
 }
 
-void TankAi::updateVisionCone(Tank const& playerTank)
+////////////////////////////////////////////////////////////
+void TankAi::updateBoxes(int tank, bool force)
 {
-	// store ai turret and player positions
-	sf::Vector2f AIturretPos = m_turret.getPosition();
-	sf::Vector2f playerTankPos = playerTank.getPosition();
-
-	// update locations of vision cone origin
-	m_visionConeLeft = AIturretPos;
-	m_visionConeRight = AIturretPos;
-	m_arrowLeft.setPosition(m_visionConeLeft);
-	m_arrowRight.setPosition(m_visionConeRight);
+	// both boxes turn about the tank's position, so a move rebuilds both
+	bool const moved = force || m_position[tank] != m_boxPosition[tank];
+	if (moved || m_rotation[tank] != m_baseBoxRotation[tank])
+	{
+		m_baseBox[tank].set(placeSprite(m_tankBase, m_position[tank], m_rotation[tank]));
+		m_baseBoxRotation[tank] = m_rotation[tank];
+	}
+	if (moved || m_turretRotation[tank] != m_turretBoxRotation[tank])
+	{
+		m_turretBox[tank].set(placeSprite(m_turret, m_position[tank], m_turretRotation[tank]));
+		m_turretBoxRotation[tank] = m_turretRotation[tank];
+	}
+	m_boxPosition[tank] = m_position[tank];
+}
 
-	// directions each arrow points in
-	sf::Vector2f arrowLeftDirection;
-	sf::Vector2f arrowRightDirection;
+void TankAi::updateVisionCones(Tank const& playerTank)
+{
+	sf::Vector2f playerTankPos = playerTank.getPosition();
+	int const tanks = count();
 
-	// end points of each arrow
-	sf::Vector2f arrowLeftEndPoint;
-	sf::Vector2f arrowRightEndPoint;
-	
-	switch (m_aiBehaviour)
+	// build the cones of the tanks looking this step first, so they can all be checked at once.
+	// Once chasing, the player is only lost by leaving the cone's angle or hiding behind a
+	// wall, not by distance
+	m_cones.clear();
+	for (int i = 0; i < tanks; i++)
 	{
-	case AiBehaviour::ATTACK_PLAYER: // chasing player, longer and narrower vision cone
+		float length;
+		float halfAngle;
+		float angle;
+		SightQuery cone;
 
-		// player halfway inside cone, make cone wider but shorter
-		if (distanceBetween(playerTankPos, AIturretPos) <= visionConeLengthAttack / 2)
-		{
-			arrowLeftDirection = visionConeLengthPlayerHalfway * thor::rotatedVector(m_visionConeDir, m_rotation - visionConeAnglePlayerHalfway);
-			arrowRightDirection = visionConeLengthPlayerHalfway * thor::rotatedVector(m_visionConeDir, m_rotation + visionConeAnglePlayerHalfway);
-		}
-		else // keep narrowed and longer vision cone
+		switch (m_behaviour[i])
 		{
-			arrowLeftDirection = visionConeLengthAttack * thor::rotatedVector(m_visionConeDir, m_rotation - visionConeAngleAttack);
-			arrowRightDirection = visionConeLengthAttack * thor::rotatedVector(m_visionConeDir, m_rotation + visionConeAngleAttack);
-		}
-
-		m_arrowLeft.setDirection(arrowLeftDirection);
-		m_arrowRight.setDirection(arrowRightDirection);
+		case AiBehaviour::ATTACK_PLAYER: // chasing player, longer and narrower vision cone
 
-		arrowLeftEndPoint = AIturretPos + arrowLeftDirection;
-		arrowRightEndPoint = AIturretPos + arrowRightDirection;
+			angle = m_rotation[i];
 
-		if (isLeft(arrowLeftEndPoint, AIturretPos, playerTankPos) == false &&
-			isLeft(arrowRightEndPoint, AIturretPos, playerTankPos))
-		{
-			// player still in cone, no change needed
-
-			// set timer back to 3 seconds
-			// probably inefficent to keep reseting timer but this prevents bug
-			// bug in question: leaving the vision cone starts the timer to switch back to patrol. Lets say a player leaves the cone for 2 seconds, then enters the cone again.
-			// after 1 second (the time remaining on the switch delay), the AI will switch back to patrol, even if the player is still in the cone. Reseting the timer here ensures the player 
-			// has to be outside the cone for a full 3 seconds for the ai to switch
-			m_backToPatrolDelay.reset(sf::Time(sf::seconds(DELAY)));
-		}
-		else
-		{
-			// start 3 second delay to change back to Patrol
-			m_backToPatrolDelay.start();
+			// player halfway inside cone, make cone wider but shorter
+			if (distanceBetween(playerTankPos, m_position[i]) <= visionConeLengthAttack / 2)
+			{
+				length = visionConeLengthPlayerHalfway;
+				halfAngle = visionConeAnglePlayerHalfway;
+			}
+			else // keep narrowed and longer vision cone
+			{
+				length = visionConeLengthAttack;
+				halfAngle = visionConeAngleAttack;
+			}
+			cone = visionCone(i, angle, std::numeric_limits<float>::max(), halfAngle);
+			break;
+
+		case AiBehaviour::PATROL: // moving to random point on map, shorter and wider vision cone that sweeps 360 degrees
+		default:
+			angle = m_visionConeSweepAngle[i];
+			length = visionConeLengthPatrol;
+			halfAngle = visionConeAnglePatrol;
+			cone = visionCone(i, angle, length, halfAngle);
+			break;
 		}
 
-		if (m_backToPatrolDelay.isExpired())
+		m_visionConeLeft[i] = length * thor::rotatedVector(m_visionConeDir, angle - halfAngle);
+		m_visionConeRight[i] = length * thor::rotatedVector(m_visionConeDir, angle + halfAngle);
+
+		if (m_deciding[i])
 		{
-			m_aiBehaviour = AiBehaviour::PATROL;
-			m_backToPatrolDelay.reset(sf::Time(sf::seconds(DELAY)));
+			m_cones.push_back(cone);
 		}
+	}
 
-		break;
-
-	case AiBehaviour::PATROL: // moving to random point on map, shorter and wider vision cone that sweeps 360 degrees
-		arrowLeftDirection = visionConeLengthPatrol * thor::rotatedVector(m_visionConeDir, m_visionConeSweepAngle - visionConeAnglePatrol);
-		m_arrowLeft.setDirection(arrowLeftDirection);
-		arrowRightDirection = visionConeLengthPatrol * thor::rotatedVector(m_visionConeDir, m_visionConeSweepAngle + visionConeAnglePatrol);
-		m_arrowRight.setDirection(arrowRightDirection);
+	// checks whether the player is inside each cone and not hidden behind a wall
+	m_lineOfSight.canSee(m_cones.data(), static_cast<int>(m_cones.size()), playerTankPos, m_seen.get());
 
-		arrowLeftEndPoint = AIturretPos + arrowLeftDirection;
-		arrowRightEndPoint = AIturretPos + arrowRightDirection;
+	int nextCone = 0;
+	for (int i = 0; i < tanks; i++)
+	{
+		// a tank that is not looking this step can not spot the player
+		bool seen = m_deciding[i] && m_seen[nextCone++];
 
-		// check if player could be seen by ai
-		if (distanceBetween(playerTankPos, AIturretPos) <= visionConeLengthPatrol)
+		switch (m_behaviour[i])
 		{
-			// check if player is in the vision cone, player is to the right of left arrow and to the left of the right arrow
-			if (isLeft(arrowLeftEndPoint, AIturretPos, playerTankPos) == false &&
-				isLeft(arrowRightEndPoint, AIturretPos, playerTankPos))
+		case AiBehaviour::ATTACK_PLAYER:
+			if (seen)
 			{
-				// tank has spotted player, switch behaviour
-				m_aiBehaviour = AiBehaviour::ATTACK_PLAYER;
-				m_rotation = m_visionConeSweepAngle;
-				
+				// player still in cone and not hidden behind a wall, no change needed
+
+				// set timer back to 3 seconds
+				// probably inefficent to keep reseting timer but this prevents bug
+				// bug in question: leaving the vision cone starts the timer to switch back to patrol. Lets say a player leaves the cone for 2 seconds, then enters the cone again.
+				// after 1 second (the time remaining on the switch delay), the AI will switch back to patrol, even if the player is still in the cone. Reseting the timer here ensures the player
+				// has to be outside the cone for a full 3 seconds for the ai to switch
+				m_backToPatrolDelay[i].reset(sf::Time(sf::seconds(DELAY)));
+			}
+			else
+			{
+				// start 3 second delay to change back to Patrol
+				m_backToPatrolDelay[i].start();
 			}
-		}
 
-		m_visionConeSweepAngle += 0.5f;
+			if (m_backToPatrolDelay[i].isExpired())
+			{
+				m_behaviour[i] = AiBehaviour::PATROL;
+				m_backToPatrolDelay[i].reset(sf::Time(sf::seconds(DELAY)));
+			}
+			break;
 
-		if (m_visionConeSweepAngle == 360.0f)
-		{
-			m_visionConeSweepAngle = 0;
-		}
+		case AiBehaviour::PATROL:
+			if (seen)
+			{
+				// tank has spotted player, switch behaviour
+				m_behaviour[i] = AiBehaviour::ATTACK_PLAYER;
+				m_rotation[i] = m_visionConeSweepAngle[i];
+				updateBoxes(i, false);
+			}
 
-		break;
+			m_visionConeSweepAngle[i] += 0.5f;
 
-	default:
-		break;
+			if (m_visionConeSweepAngle[i] == 360.0f)
+			{
+				m_visionConeSweepAngle[i] = 0;
+			}
+			break;
+
+		default:
+			break;
+		}
 	}
 }
 
-void TankAi::processBullets(double dt, Tank & playerTank)
+void TankAi::processBullets(int tank, double dt, Tank & playerTank, SimEvents& t_events)
 {
+	Bullet* bullets = &m_AIBullets[tank * NUM_AI_BULLETS];
+	SimTimer& firingTimer = m_firingTimer[tank];
+
 	for (int i = 0; i < NUM_AI_BULLETS; i++)
 	{
 		// only allow another bullet to be fired after 1 second
-		if (m_firingTimer.isExpired())
+		if (firingTimer.isExpired())
 		{
 			// only allow bullets to be fired in attack player behaviour
-			if (m_aiBehaviour == AiBehaviour::ATTACK_PLAYER)
+			if (m_behaviour[tank] == AiBehaviour::ATTACK_PLAYER)
 			{
 				// check if bullet is ready to be fired
-				if (m_AIBullets[i].m_canFire)
+				if (bullets[i].m_canFire)
 				{
 					// check if in reasonable distance to player
-					if (distanceBetween(playerTank.getPosition(), m_turret.getPosition()) <= visionConeLengthAttack * 0.75)
+					if (distanceBetween(playerTank.getPosition(), m_position[tank]) <= visionConeLengthAttack * 0.75)
 					{
-						m_AIBullets[i].m_firing = true;
-						m_AIBullets[i].m_canFire = false;
+						bullets[i].m_firing = true;
+						bullets[i].m_canFire = false;
 					}
 				}
 			}
-		
+
 			// bullet being fired, reset timer and find start point
-			if (m_AIBullets[i].m_firing)
+			if (bullets[i].m_firing)
 			{
-				m_firingTimer.reset(sf::Time(sf::seconds(FIRING_COOLDOWN)));
-				m_firingTimer.start();
+				firingTimer.reset(sf::Time(sf::seconds(FIRING_COOLDOWN)));
+				firingTimer.start();
 
-				m_AIBullets[i].findStartPoint(m_turret.getRotation(), m_turret.getPosition());
+				bullets[i].findStartPoint(m_turretRotation[tank], m_position[tank]);
 			}
 		}
 
 		// if start point is found, move bullet along created vector
-		if (m_AIBullets[i].m_traveling)
+		if (bullets[i].m_traveling)
 		{
-			m_AIBullets[i].update(dt);
-			m_AIBullets[i].wallCollision(m_wallSprites);
+			bullets[i].update(dt);
+			if (bullets[i].wallCollision(m_walls))
+			{
+				t_events.m_wallHits++;
+			}
 
 			// BROKEN
-			//m_AIBullets[i].playerCollision(playerTank);
-			
+			//bullets[i].playerCollision(playerTank);
+
 		}
 	}
 }
 
-bool TankAi::isLeft(sf::Vector2f t_linePoint1, sf::Vector2f t_linePoint2, sf::Vector2f t_point) const
+SightQuery TankAi::visionCone(int tank, float t_angle, float t_length, float t_halfAngle) const
 {
-	/*bool isLeft(sf::Vector2f t_linePoint1,
-		sf::Vector2f t_linePoint2,
-		sf::Vector2f t_point) const*/
-	
-	// return ( (x2-x1) * (y3-y1) ) - ( (y2 - y1) * (x3-x1) )
-
-	return ((t_linePoint2.x - t_linePoint1.x) *
-		(t_point.y - t_linePoint1.y) -
-		(t_linePoint2.y - t_linePoint1.y) *
-		(t_point.x - t_linePoint1.x)) > 0;
-
+	SightQuery cone;
+	cone.m_eye = m_position[tank];
+	cone.m_facing = thor::rotatedVector(m_visionConeDir, t_angle);
+	cone.m_range = t_length;
+	cone.m_halfAngle = t_halfAngle;
+	return cone;
 }
@@ -0,0 +1,134 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::add(std::string const& t_name, std::string const& t_fileName)
+{
+	m_files.emplace_back(t_name, t_fileName);
+}
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::build()
+{
+	m_regions.clear();
+	m_pages.clear();
+
+	std::vector<sf::Image> images(m_files.size());
+	for (std::size_t i = 0; i < m_files.size(); i++)
+	{
+		if (!images[i].loadFromFile(m_files[i].second))
+		{
+			throw std::runtime_error("Error loading " + m_files[i].second);
+		}
+	}
+
+	// the first image stays first, the rest go tallest first as that leaves the least space in the shelves
+	std::vector<std::size_t> order(images.size());
+	for (std::size_t i = 0; i < order.size(); i++)
+	{
+		order[i] = i;
+	}
+	if (order.size() > 1)
+	{
+		std::stable_sort(order.begin() + 1, order.end(), [&images](std::size_t t_a, std::size_t t_b)
+		{
+			return images[t_a].getSize().y > images[t_b].getSize().y;
+		});
+	}
+
+	unsigned const pageSize = std::min(MAX_PAGE_SIZE, sf::Texture::getMaximumSize());
+
+	// the images on each page, and how much of each page is used
+	std::vector<std::vector<std::size_t>> pageImages;
+	std::vector<sf::Vector2u> pageUsed;
+
+	unsigned x = 0;
+	unsigned y = 0;
+	unsigned shelfHeight = 0;
+	for (std::size_t index : order)
+	{
+		sf::Vector2u const size = images[index].getSize();
+		if (size.x > pageSize || size.y > pageSize)
+		{
+			throw std::runtime_error(m_files[index].second + " is larger than a texture atlas page");
+		}
+
+		// start a new shelf when the image does not fit on this one, and a new page when the
+		// shelf does not fit on this page
+		if (pageImages.empty() || x + size.x > pageSize)
+		{
+			x = 0;
+			y += shelfHeight;
+			shelfHeight = 0;
+		}
+		if (pageImages.empty() || y + size.y > pageSize)
+		{
+			pageImages.emplace_back();
+			pageUsed.emplace_back(0, 0);
+			x = 0;
+			y = 0;
+			shelfHeight = 0;
+		}
+
+		Region region;
+		region.m_page = static_cast<int>(pageImages.size()) - 1;
+		region.m_rect = sf::IntRect(x, y, size.x, size.y);
+		m_regions[m_files[index].first] = region;
+		pageImages.back().push_back(index);
+
+		sf::Vector2u& used = pageUsed.back();
+		used.x = std::max(used.x, x + size.x);
+		used.y = std::max(used.y, y + size.y);
+
+		x += size.x + PADDING;
+		shelfHeight = std::max(shelfHeight, size.y + PADDING);
+	}
+
+	// copy the images onto each page, trimmed to the space used, and upload it
+	for (std::size_t page = 0; page < pageImages.size(); page++)
+	{
+		sf::Image pageImage;
+		pageImage.create(pageUsed[page].x, pageUsed[page].y, sf::Color::Transparent);
+		for (std::size_t index : pageImages[page])
+		{
+			sf::IntRect const& rect = m_regions[m_files[index].first].m_rect;
+			pageImage.copy(images[index], rect.left, rect.top);
+		}
+
+		m_pages.push_back(std::make_unique<sf::Texture>());
+		if (!m_pages.back()->loadFromImage(pageImage))
+		{
+			throw std::runtime_error("Error creating texture atlas page");
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+sf::Texture const& TextureAtlas::texture(std::string const& t_name) const
+{
+	return *m_pages[region(t_name).m_page];
+}
+
+////////////////////////////////////////////////////////////
+sf::IntRect TextureAtlas::rect(std::string const& t_name) const
+{
+	return region(t_name).m_rect;
+}
+
+////////////////////////////////////////////////////////////
+int TextureAtlas::pageCount() const
+{
+	return static_cast<int>(m_pages.size());
+}
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Region const& TextureAtlas::region(std::string const& t_name) const
+{
+	auto found = m_regions.find(t_name);
+	if (found == m_regions.end())
+	{
+		throw std::runtime_error("No image called " + t_name + " in the texture atlas");
+	}
+	return found->second;
+}
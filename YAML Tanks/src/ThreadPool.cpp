@@ -0,0 +1,168 @@
+#include "ThreadPool.h"
+
+// the pool and queue of the worker running on this thread, if any
+static thread_local ThreadPool* s_currentPool = nullptr;
+static thread_local unsigned s_currentIndex = 0;
+
+////////////////////////////////////////////////////////////
+ThreadPool::ThreadPool(unsigned t_threadCount)
+{
+	if (t_threadCount == 0)
+	{
+		t_threadCount = std::thread::hardware_concurrency();
+	}
+	if (t_threadCount == 0)
+	{
+		t_threadCount = 1;
+	}
+
+	for (unsigned i = 0; i < t_threadCount; i++)
+	{
+		m_queues.push_back(std::make_unique<WorkQueue>());
+	}
+	for (unsigned i = 0; i < t_threadCount; i++)
+	{
+		m_threads.emplace_back(&ThreadPool::workerLoop, this, i);
+	}
+}
+
+////////////////////////////////////////////////////////////
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_stopping = true;
+	}
+	m_wake.notify_all();
+
+	for (std::thread& thread : m_threads)
+	{
+		thread.join();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ThreadPool::submit(std::function<void()> t_task)
+{
+	unsigned index;
+	if (s_currentPool == this)
+	{
+		index = s_currentIndex;
+	}
+	else
+	{
+		index = m_nextQueue++ % m_queues.size();
+	}
+
+	m_pending++;
+	{
+		std::lock_guard<std::mutex> lock(m_queues[index]->m_mutex);
+		m_queues[index]->m_tasks.push_back(std::move(t_task));
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_queued++;
+	}
+	m_wake.notify_one();
+}
+
+////////////////////////////////////////////////////////////
+void ThreadPool::wait()
+{
+	std::unique_lock<std::mutex> lock(m_wakeMutex);
+	m_idle.wait(lock, [this] { return m_pending == 0; });
+
+	if (m_error)
+	{
+		std::exception_ptr error = m_error;
+		m_error = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+////////////////////////////////////////////////////////////
+unsigned ThreadPool::threadCount() const
+{
+	return static_cast<unsigned>(m_threads.size());
+}
+
+////////////////////////////////////////////////////////////
+void ThreadPool::workerLoop(unsigned t_index)
+{
+	s_currentPool = this;
+	s_currentIndex = t_index;
+
+	std::function<void()> task;
+	while (true)
+	{
+		if (popTask(t_index, task))
+		{
+			runTask(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		m_wake.wait(lock, [this] { return m_queued > 0 || m_stopping; });
+		if (m_stopping && m_queued == 0)
+		{
+			return;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool ThreadPool::popTask(unsigned t_index, std::function<void()>& t_task)
+{
+	// newest task from our own queue first, it is the most likely to be in cache
+	{
+		WorkQueue& own = *m_queues[t_index];
+		std::lock_guard<std::mutex> lock(own.m_mutex);
+		if (!own.m_tasks.empty())
+		{
+			t_task = std::move(own.m_tasks.back());
+			own.m_tasks.pop_back();
+			m_queued--;
+			return true;
+		}
+	}
+
+	// otherwise steal the oldest task from another worker
+	for (unsigned i = 1; i < m_queues.size(); i++)
+	{
+		WorkQueue& victim = *m_queues[(t_index + i) % m_queues.size()];
+		std::lock_guard<std::mutex> lock(victim.m_mutex);
+		if (!victim.m_tasks.empty())
+		{
+			t_task = std::move(victim.m_tasks.front());
+			victim.m_tasks.pop_front();
+			m_queued--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+void ThreadPool::runTask(std::function<void()>& t_task)
+{
+	try
+	{
+		t_task();
+	}
+	catch (...)
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		if (!m_error)
+		{
+			m_error = std::current_exception();
+		}
+	}
+	t_task = nullptr;
+
+	if (--m_pending == 0)
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_idle.notify_all();
+	}
+}
@@ -0,0 +1,424 @@
+#include "World.h"
+#include "ScreenSize.h"
+#include <iostream>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////
+World::World(sf::Texture const& t_spriteSheet, sf::Texture const& t_targetTexture, int t_levelNr, std::uint64_t t_seed)
+	: m_random(t_seed)
+	, m_seed(t_seed)
+	, m_raycaster(m_walls, m_targetBoxes, m_level.m_targets)
+	, m_lineOfSight(m_raycaster)
+	, m_paths(m_navGrid)
+	, m_flowField(m_navGrid)
+	, m_tank(t_spriteSheet, m_walls, m_targetBoxes, m_level.m_targets, m_clock)
+	, m_aiTanks(t_spriteSheet, m_wallSprites, m_walls, m_lineOfSight, m_navGrid, m_paths, m_flowField, m_clock, m_random)
+	, m_texture(t_spriteSheet)
+	, m_targetTexture(t_targetTexture)
+	, m_timer(m_clock)
+	, m_targetTimer(m_clock)
+{
+	// Will generate an exception if level loading fails.
+	try
+	{
+		LevelLoader::load(t_levelNr, m_level, m_random);
+	}
+	catch (std::exception& e)
+	{
+		std::cout << "Level Loading failure." << std::endl;
+		std::cout << e.what() << std::endl;
+		throw;
+	}
+
+	// Now the level data is loaded, set the tank position
+	m_tank.setPosition(m_level.m_tank.m_position);
+
+	// generate the walls and targets in the game
+	generateWalls();
+	generateTargets();
+
+	// timer set to 60 seconds
+	m_timer.reset(sf::Time(sf::seconds(TIMER_DURATION)));
+	// Initiate the timer
+	m_timer.start();
+
+	// target timer set to 10 seconds
+	m_targetTimer.reset(sf::Time(sf::seconds(m_level.m_targets[0].m_duration)));
+	// Initiate the target timer
+	m_targetTimer.start();
+
+	// Populate the obstacle list and create the AI tanks and their vision cones
+	m_aiTanks.init(m_level.m_aiTanks);
+}
+
+////////////////////////////////////////////////////////////
+void World::step(double dt, InputCommand const& t_input)
+{
+	m_events.clear();
+
+	m_tank.storePreviousState();
+	m_aiTanks.storePreviousState();
+
+	if (m_aiTanks.collidesWithPlayer(m_tank))
+	{
+		m_gameState = GameState::GAME_LOSE;
+	}
+
+	if (m_gameState != GameState::GAME_RUNNING)
+	{
+		return;
+	}
+
+	m_clock.advance(dt);
+
+	m_tank.update(dt, t_input, m_events);
+
+	if (m_tank.m_fuel <= 0)
+	{
+		m_gameState = GameState::GAME_LOSE;
+	}
+
+	// the tanks have moved since the last step, rays cast by the AI need their new boxes
+	m_raycaster.setTankBox(Raycaster::PLAYER_TANK, m_tank.getBaseBox());
+	for (int i = 0; i < m_aiTanks.count(); i++)
+	{
+		m_raycaster.setTankBox(Raycaster::AI_TANK + i, m_aiTanks.getBaseBox(i));
+	}
+	m_lineOfSight.beginStep();
+	m_paths.update();
+	m_flowField.setGoal(m_tank.getPosition());
+
+	m_aiTanks.update(m_tank, dt, m_events);
+
+	updateCargoMode();
+
+	updateTargets();
+
+	updateGameTimer();
+}
+
+////////////////////////////////////////////////////////////
+void World::render(SpriteBatch& t_batch, float alpha)
+{
+	// draws the active target
+	for (int i = 0; i < m_level.m_targets.size(); i++)
+	{
+		if (m_level.m_targets[i].m_active)
+		{
+			t_batch.draw(m_targetSprites[i], DrawLayer::TARGETS);
+		}
+	}
+
+	m_tank.render(t_batch, alpha);
+
+	m_aiTanks.render(t_batch, alpha);
+
+	m_cargoMode.render(t_batch);
+
+	// draws active player bullets
+	for (int i = 0; i < NUM_PLAYER_BULLETS; i++)
+	{
+		m_tank.m_bullets[i].render(t_batch, alpha);
+	}
+
+	// draws active ai bullets
+	for (Bullet& bullet : m_aiTanks.m_AIBullets)
+	{
+		bullet.render(t_batch, alpha);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void World::renderOverlay(sf::RenderTarget& t_target, float alpha)
+{
+	m_aiTanks.renderOverlay(t_target, alpha);
+}
+
+////////////////////////////////////////////////////////////
+void World::setTargetTextureRect(sf::IntRect const& t_rect)
+{
+	if (t_rect.width != TARGET_SIZE || t_rect.height != TARGET_SIZE)
+	{
+		throw std::runtime_error("Target image does not match the size the targets were built with");
+	}
+
+	for (sf::Sprite& sprite : m_targetSprites)
+	{
+		sprite.setTextureRect(t_rect);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void World::renderStatic(sf::RenderTarget& t_target) const
+{
+	// draws the wall obstacles, they all share the sprite sheet
+	t_target.draw(m_wallVertices, &m_texture);
+}
+
+////////////////////////////////////////////////////////////
+void World::saveState(StateWriter& t_writer) const
+{
+	m_clock.saveState(t_writer);
+	for (std::uint32_t word : m_random.m_state)
+	{
+		t_writer.write(word);
+	}
+
+	t_writer.writeVarint(m_level.m_targets.size());
+	for (TargetData const& target : m_level.m_targets)
+	{
+		t_writer.write(target.m_active);
+		t_writer.write(target.m_removedFromGame);
+		t_writer.write(target.m_shot);
+	}
+
+	m_tank.saveState(t_writer);
+	m_paths.saveState(t_writer);
+	m_aiTanks.saveState(t_writer);
+	m_cargoMode.saveState(t_writer);
+
+	t_writer.write(m_gameState);
+	t_writer.writeString(m_objectiveString);
+	t_writer.write(m_timeRemaining);
+	t_writer.write(m_remainingTime);
+	t_writer.write(m_targetVanishing);
+	t_writer.write(m_vanishingTarget);
+	t_writer.write(m_playerScore);
+	t_writer.write(m_targetsHit);
+	t_writer.write(m_accuracy);
+	m_timer.saveState(t_writer);
+	m_targetTimer.saveState(t_writer);
+}
+
+////////////////////////////////////////////////////////////
+void World::loadState(StateReader& t_reader)
+{
+	m_clock.loadState(t_reader);
+	for (std::uint32_t& word : m_random.m_state)
+	{
+		t_reader.read(word);
+	}
+
+	if (t_reader.readVarint() != m_level.m_targets.size())
+	{
+		throw std::runtime_error("World snapshot does not match the loaded level");
+	}
+	for (TargetData& target : m_level.m_targets)
+	{
+		t_reader.read(target.m_active);
+		t_reader.read(target.m_removedFromGame);
+		t_reader.read(target.m_shot);
+	}
+
+	m_tank.loadState(t_reader);
+	m_paths.loadState(t_reader);
+	m_aiTanks.loadState(t_reader);
+	m_cargoMode.loadState(t_reader);
+
+	t_reader.read(m_gameState);
+	m_objectiveString = t_reader.readString();
+	t_reader.read(m_timeRemaining);
+	t_reader.read(m_remainingTime);
+	t_reader.read(m_targetVanishing);
+	t_reader.read(m_vanishingTarget);
+	t_reader.read(m_playerScore);
+	t_reader.read(m_targetsHit);
+	t_reader.read(m_accuracy);
+	m_timer.loadState(t_reader);
+	m_targetTimer.loadState(t_reader);
+
+	m_events.clear();
+}
+
+void World::generateWalls()
+{
+	sf::IntRect wallRect(2, 129, 33, 23);
+	// Create the Walls
+	for (ObstacleData const& obstacle : m_level.m_obstacles)
+	{
+		sf::Sprite sprite;
+		sprite.setTexture(m_texture);
+		sprite.setTextureRect(wallRect);
+		sprite.setOrigin(wallRect.width / 2.0, wallRect.height / 2.0);
+		sprite.setPosition(obstacle.m_position);
+		sprite.setRotation(obstacle.m_rotation);
+		m_wallSprites.push_back(sprite);
+	}
+
+	// the walls never move, so their vertices, boxes and grid are only built once
+	bakeWallVertices();
+	m_walls.build(m_wallSprites, WALL_GRID_CELL_SIZE);
+	m_navGrid.build(m_walls, ScreenSize::s_width, ScreenSize::s_height, NAV_CELL_SIZE, NAV_CLEARANCE);
+}
+
+////////////////////////////////////////////////////////////
+void World::bakeWallVertices()
+{
+	m_wallVertices.setPrimitiveType(sf::Triangles);
+	m_wallVertices.resize(m_wallSprites.size() * SpriteBatch::VERTICES_PER_SPRITE);
+
+	for (std::size_t i = 0; i < m_wallSprites.size(); i++)
+	{
+		SpriteBatch::spriteVertices(m_wallSprites[i], &m_wallVertices[i * SpriteBatch::VERTICES_PER_SPRITE]);
+	}
+}
+
+void World::generateTargets()
+{
+	sf::IntRect targetRect(0, 0, TARGET_SIZE, TARGET_SIZE);
+
+	// Create the targets
+	for (TargetData const& target : m_level.m_targets)
+	{
+		sf::Sprite sprite;
+		sprite.setTexture(m_targetTexture);
+		sprite.setTextureRect(targetRect);
+		sprite.setPosition(target.m_position);
+		m_targetSprites.push_back(sprite);
+		m_targetBoxes.emplace_back(sprite);
+	}
+}
+
+void World::updateCargoMode()
+{
+	// cargo not picked up yet
+	if (m_cargoMode.m_cargoCollected == false)
+	{
+		if (m_cargoMode.playerPicksUpCargo(m_tank))
+		{
+			m_cargoMode.m_cargoCollected = true;
+			m_objectiveString = "Deliver Ammo To Base!";
+		}
+	}
+	else // cargo picked up, check if player is at goal
+	{
+		if (m_cargoMode.playerArrivesAtGoal(m_tank))
+		{
+			m_objectiveString = "Delivered Cargo!";
+			m_gameState = GameState::GAME_WIN;
+		}
+	}
+
+	// fuel not picked up yet
+	if (m_cargoMode.m_fuelPickedUp == false)
+	{
+		// player is on fuel pickup
+		if (m_cargoMode.playerPicksUpFuel(m_tank))
+		{
+			m_tank.m_fuel += 1000;
+
+			// prevent over refilling
+			if (m_tank.m_fuel > 3000)
+			{
+				m_tank.m_fuel = 3000;
+			}
+			m_cargoMode.m_fuelPickedUp = true;
+		}
+	}
+}
+
+void World::updateTargets()
+{
+	for (int i = 0; i < m_level.m_targets.size(); i++)
+	{
+		TargetData& target = m_level.m_targets[i];
+
+		if (target.m_active)
+		{
+			remainingTargetTime(i);
+
+			if (target.m_shot)
+			{
+				targetShot(i);
+			}
+		}
+
+		//target can only pop up when previous target time has expired
+		if (m_targetTimer.isExpired())
+		{
+			if (target.m_active == false && target.m_removedFromGame == false)
+			{
+				// current target is not active, deactivate last one and activate current one
+				genNextTarget(i);
+
+			}
+			//removes last final target if player manages to break them all before time runs out
+			else if (target.m_active == true && i == m_level.m_targets.size() - 1)
+			{
+				target.m_active = false;
+				target.m_removedFromGame = true;
+			}
+		}
+	}
+}
+
+void World::remainingTargetTime(int i)
+{
+	m_remainingTime = m_targetTimer.getRemainingTime().asSeconds();
+
+	if (m_remainingTime < 5)
+	{
+		m_vanishingTarget = i;
+		m_targetVanishing = true;
+	}
+}
+
+void World::targetShot(int i)
+{
+	TargetData& target = m_level.m_targets[i];
+
+	m_events.m_targetsHit++;
+	m_targetTimer.reset(sf::Time(sf::seconds(target.m_duration + m_remainingTime)));
+	m_targetTimer.start();
+	m_targetVanishing = false;
+	target.m_removedFromGame = true;
+	target.m_active = false;
+	m_playerScore += 10;
+	m_targetsHit++;
+}
+
+void World::genNextTarget(int i)
+{
+	TargetData& target = m_level.m_targets[i];
+
+	// prevent trying to access a previous target that doesnt exist
+	if (i > 0)
+	{
+		// if previous target does exist, deactivate it and remove it from the game to prevent it being activated again
+		TargetData& previousTarget = m_level.m_targets[i - 1];
+		previousTarget.m_active = false;
+		previousTarget.m_removedFromGame = true;
+	}
+
+	m_events.m_targetsAppeared++;
+
+	// reset timer and activate new target
+	m_targetTimer.reset(sf::Time(sf::seconds(target.m_duration)));
+	m_targetTimer.start();
+
+	target.m_active = true;
+	// disable target vanishing warning
+	m_targetVanishing = false;
+}
+
+void World::updateGameTimer()
+{
+	// get time remaining as seconds
+	m_timeRemaining = m_timer.getRemainingTime().asSeconds();
+
+	// when game time reaches 0, game is over (stops rendering and updating, displays game over screen)
+	if (m_timer.isExpired())
+	{
+		m_gameState = GameState::GAME_WIN;
+		m_objectiveString = "Time Ran Out!";
+
+		if (m_targetsHit && m_tank.m_bulletsFired != 0)
+		{
+			m_accuracy = (m_targetsHit / m_tank.m_bulletsFired) * 100;
+		}
+		else
+		{
+			m_accuracy = 0;
+		}
+	}
+}
@@ -19,20 +19,29 @@
 
 
 #include "Game.h"
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
 
 /// <summary>
 /// @brief starting point for all C++ programs.
 /// 
 /// Create a game object and run it.
+/// An optional seed can be given on the command line to replay a particular match,
+///  otherwise the seed is taken from the current time.
 /// </summary>
-/// <param name=""></param>
+/// <param name="argc"></param>
 /// <param name="argv"></param>
 /// <returns></returns>
-int main(int, char* argv[])
+int main(int argc, char* argv[])
 {
-	// set a random number generator seed
-	srand(time(NULL));
+	std::uint64_t seed = static_cast<std::uint64_t>(std::time(nullptr));
+	if (argc > 1)
+	{
+		seed = std::strtoull(argv[1], nullptr, 10);
+	}
+	std::cout << "Match seed: " << seed << std::endl;
 
-	Game game;
+	Game game(seed);
 	game.run();
 }
\ No newline at end of file